@@ -11,18 +11,30 @@
 
 #ifndef GAMEMAP_HPP
 #define GAMEMAP_HPP
+#include <cstdint>
+#include <span>
+#include <stdexcept>
 #include <vector>
 #include <string>
-#include <map>
+#include <string_view>
 #include <fstream>
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bitset>
+#include <bit>
+#include <chrono>
 #include <filesystem>
+#include <memory>
 #include <unordered_map>
+#include <utility>
 #include <iostream>
 
+#include "gridKernels.hpp"
 #include "my.hpp"
 namespace Arcade
 {
-    enum class EntityType {
+    enum class EntityType : uint8_t {
         EMPTY,      // Case vide (ex: terrain par défaut)
         WALL,       // Mur ou obstacle
         PLAYER,     // Joueur (Serpent, Pacman, Vaisseau, etc.)
@@ -36,21 +48,574 @@ namespace Arcade
         SNAKE_BODY, // Corps du serpent
     };
 
+    inline constexpr size_t ENTITY_TYPE_COUNT = static_cast<size_t>(EntityType::SNAKE_BODY) + 1;
+
+    /*
+     * Couches d'une carte en couches : le décor, figé pendant un niveau ;
+     * les objets à ramasser ; les acteurs qui se déplacent, tenus à part en
+     * liste. La grille vue par les rendus est leur superposition.
+     */
+    enum class MapLayer : uint8_t {
+        TERRAIN,
+        ITEMS,
+        ACTORS
+    };
+
+    inline MapLayer layerOf(EntityType type)
+    {
+        switch (type) {
+            case EntityType::BONUS:
+            case EntityType::BIG_BONUS:
+            case EntityType::PROJECTILE:
+                return MapLayer::ITEMS;
+            case EntityType::PLAYER:
+            case EntityType::ENEMY:
+            case EntityType::SNAKE_HEAD:
+            case EntityType::SNAKE_BODY:
+                return MapLayer::ACTORS;
+            default:
+                return MapLayer::TERRAIN;
+        }
+    }
+
+    // Acteur de la couche dynamique ; id reste valable jusqu'à son retrait
+    struct MapActor {
+        uint32_t id;
+        uint32_t x;
+        uint32_t y;
+        EntityType entity;
+    };
+
+    /*
+     * Drapeaux de la carte connus de tous les modules. Leur identifiant est
+     * fixé à la compilation : un jeu et une bibliothèque graphique chargés
+     * séparément ne partagent aucun état, un registre rempli à l'exécution
+     * donnerait des numéros différents de part et d'autre.
+     */
+    enum class MapFlag : uint8_t {
+        VICTORY,
+        PAUSED,
+        COUNT
+    };
+
+    class FlagRegistry {
+        public:
+            static constexpr size_t CAPACITY = 64;
+            static constexpr std::array<const char *, static_cast<size_t>(MapFlag::COUNT)> NAMES = {
+                "VICTORY",
+                "PAUSED",
+            };
+
+            // Identifiant d'un nom connu, ou CAPACITY s'il n'en a pas
+            static size_t find(std::string_view name) {
+                for (size_t id = 0; id < NAMES.size(); ++id) {
+                    if (name == NAMES[id])
+                        return id;
+                }
+                return CAPACITY;
+            }
+
+            static const char *name(MapFlag flag) {
+                return NAMES[static_cast<size_t>(flag)];
+            }
+    };
+    static_assert(static_cast<size_t>(MapFlag::COUNT) <= FlagRegistry::CAPACITY, "Trop de drapeaux pour le bitset");
+
+    // Correspondance caractère <-> entité des cartes texte (.map)
+    inline EntityType entityFromSymbol(char symbol)
+    {
+        switch (symbol) {
+            case '#': return EntityType::WALL;
+            case 'P': return EntityType::PLAYER;
+            case 'E': return EntityType::ENEMY;
+            case 'B': return EntityType::BONUS;
+            case 'O': return EntityType::BIG_BONUS;
+            case 'X': return EntityType::PROJECTILE;
+            case '?': return EntityType::HIDDEN;
+            case '|': return EntityType::BORDER;
+            default:  return EntityType::EMPTY;
+        }
+    }
+
+    inline char symbolOf(EntityType type)
+    {
+        switch (type) {
+            case EntityType::EMPTY:       return ' ';
+            case EntityType::WALL:        return '#';
+            case EntityType::PLAYER:      return 'P';
+            case EntityType::ENEMY:       return 'E';
+            case EntityType::BONUS:       return 'B';
+            case EntityType::BIG_BONUS:   return 'O';
+            case EntityType::PROJECTILE:  return 'X';
+            case EntityType::HIDDEN:      return '?';
+            case EntityType::BORDER:      return '|';
+            default:                      return '.';
+        }
+    }
+
+    // Une case ne stocke que son contenu : sa position découle de sa
+    // place dans la grille.
     typedef struct Cell {
-        size_t x = -1;
-        size_t y = -1;
         EntityType entity = EntityType::EMPTY;
 
-        explicit Cell() : x(0), y(0), entity(EntityType::EMPTY) {}
-        explicit Cell(size_t _x, size_t _y , EntityType type) : x(_x), y(_y), entity(type) {}
+        Cell() = default;
+        explicit Cell(EntityType type) : entity(type) {}
     } Cell;
+    static_assert(sizeof(Cell) == 1, "Cell doit rester sur un octet");
+
+    /*
+     * La grille est découpée en tuiles de CHUNK_SIZE x CHUNK_SIZE cases,
+     * allouées à la première écriture : une tuile jamais écrite est vide et
+     * ne coûte qu'un pointeur nul. Une carte de 10 000 x 10 000 où seul un
+     * serpent bouge n'occupe donc que les tuiles qu'il a traversées.
+     */
+    inline constexpr size_t CHUNK_SHIFT = 5;
+    inline constexpr size_t CHUNK_SIZE = size_t {1} << CHUNK_SHIFT;
+    inline constexpr size_t CHUNK_CELLS = CHUNK_SIZE * CHUNK_SIZE;
+
+    // Cases d'une tuile, ligne après ligne : cells[ly * CHUNK_SIZE + lx]
+    struct Chunk {
+        std::array<Cell, CHUNK_CELLS> cells {};
+    };
+
+    // Cases d'une tuile vues comme octets, pour les noyaux de gridKernels.hpp
+    inline const uint8_t *bytesOf(const Chunk& chunk) { return reinterpret_cast<const uint8_t *>(chunk.cells.data()); }
+    inline uint8_t *bytesOf(Chunk& chunk) { return reinterpret_cast<uint8_t *>(chunk.cells.data()); }
+
+    // unique_ptr recopié en profondeur, pour que GameMap reste copiable
+    template <typename T>
+    class OwnedPtr {
+        private:
+            std::unique_ptr<T> ptr;
+
+        public:
+            OwnedPtr() = default;
+            OwnedPtr(const OwnedPtr& other) : ptr(other.ptr ? std::make_unique<T>(*other.ptr) : nullptr) {}
+            OwnedPtr(OwnedPtr&&) noexcept = default;
+            OwnedPtr& operator=(const OwnedPtr& other) {
+                if (this != &other)
+                    ptr = other.ptr ? std::make_unique<T>(*other.ptr) : nullptr;
+                return *this;
+            }
+            OwnedPtr& operator=(OwnedPtr&&) noexcept = default;
+
+            explicit operator bool() const { return ptr != nullptr; }
+            T *get() const { return ptr.get(); }
+            T& operator*() const { return *ptr; }
+            T *operator->() const { return ptr.get(); }
+            T& emplace() { ptr = std::make_unique<T>(); return *ptr; }
+    };
+
+    /*
+     * Pointeur partagé à recopie sur écriture. Le compteur est dans le bloc
+     * lui-même : contrairement au bloc de contrôle d'un shared_ptr, il n'a
+     * pas de table virtuelle dans le module qui l'a créé, si bien qu'une
+     * copie de carte survit au déchargement du jeu qui l'a produite.
+     */
+    template <typename T>
+    class CowPtr {
+        private:
+            struct Node {
+                std::atomic<uint32_t> refs {1};
+                T value;
+
+                Node() = default;
+                explicit Node(const T& source) : value(source) {}
+            };
+
+            Node *node = nullptr;
+
+            void release() {
+                if (node && node->refs.fetch_sub(1, std::memory_order_acq_rel) == 1)
+                    delete node;
+                node = nullptr;
+            }
+
+        public:
+            CowPtr() = default;
+            CowPtr(const CowPtr& other) : node(other.node) {
+                if (node)
+                    node->refs.fetch_add(1, std::memory_order_relaxed);
+            }
+            CowPtr(CowPtr&& other) noexcept : node(std::exchange(other.node, nullptr)) {}
+            CowPtr& operator=(CowPtr other) noexcept {
+                std::swap(node, other.node);
+                return *this;
+            }
+            ~CowPtr() { release(); }
+
+            explicit operator bool() const { return node != nullptr; }
+            const T *get() const { return node ? &node->value : nullptr; }
+            const T& operator*() const { return node->value; }
+            const T *operator->() const { return &node->value; }
+            void reset() { release(); }
+
+            // Accès en écriture : alloue un T par défaut, ou recopie d'abord
+            // le bloc s'il est partagé avec une autre carte
+            T& write() {
+                if (!node) {
+                    node = new Node();
+                } else if (node->refs.load(std::memory_order_acquire) > 1) {
+                    Node *copy = new Node(node->value);
+                    release();
+                    node = copy;
+                }
+                return node->value;
+            }
+
+            // Écriture sans recopie, réservée aux données en ajout seul que
+            // les copies ne lisent pas (fin du journal des modifications)
+            T& append() {
+                if (!node)
+                    node = new Node();
+                return node->value;
+            }
+    };
+
+    // Une ligne de tuiles et la révision de la dernière écriture de chacune
+    struct ChunkRow {
+        std::vector<CowPtr<Chunk>> chunks;
+        std::vector<uint64_t> stamps;
+    };
+
+    /*
+     * Table des tuiles d'une carte, sur deux niveaux partagés : la liste des
+     * lignes de tuiles, puis chaque ligne. Copier une grille ne copie qu'un
+     * pointeur ; la première écriture dans une tuile partagée ne recopie que
+     * la liste, sa ligne et la tuile. Une tuile ou une ligne absente se lit
+     * comme vide.
+     */
+    class ChunkGrid {
+        private:
+            size_t width = 0;
+            size_t height = 0;
+            size_t across = 0;
+            size_t down = 0;
+            CowPtr<std::vector<CowPtr<ChunkRow>>> rows;
+
+            const ChunkRow *rowOf(size_t chunk) const {
+                return rows ? (*rows)[chunk / across].get() : nullptr;
+            }
+
+            ChunkRow& writableRow(size_t chunk) {
+                ChunkRow& row = rows.write()[chunk / across].write();
+                if (row.chunks.empty()) {
+                    row.chunks.resize(across);
+                    row.stamps.resize(across, 0);
+                }
+                return row;
+            }
+
+        public:
+            static const Chunk& emptyChunk() {
+                static const Chunk empty;
+                return empty;
+            }
+
+            void reshape(size_t newWidth, size_t newHeight) {
+                width = newWidth;
+                height = newHeight;
+                across = (width + CHUNK_SIZE - 1) >> CHUNK_SHIFT;
+                down = (height + CHUNK_SIZE - 1) >> CHUNK_SHIFT;
+                rows.reset();
+                if (across > 0)
+                    rows.write().resize(down);
+            }
+
+            size_t chunkCount() const { return across * down; }
+            size_t chunksAcross() const { return across; }
+            size_t chunkOf(size_t x, size_t y) const { return (y >> CHUNK_SHIFT) * across + (x >> CHUNK_SHIFT); }
+            static size_t offsetOf(size_t x, size_t y) { return ((y & (CHUNK_SIZE - 1)) << CHUNK_SHIFT) | (x & (CHUNK_SIZE - 1)); }
+
+            size_t originX(size_t chunk) const { return (chunk % across) << CHUNK_SHIFT; }
+            size_t originY(size_t chunk) const { return (chunk / across) << CHUNK_SHIFT; }
+            // Partie de la tuile à l'intérieur de la carte (tuiles du bord)
+            size_t visibleWidth(size_t chunk) const { return std::min(CHUNK_SIZE, width - originX(chunk)); }
+            size_t visibleHeight(size_t chunk) const { return std::min(CHUNK_SIZE, height - originY(chunk)); }
+
+            bool allocated(size_t chunk) const {
+                const ChunkRow *row = rowOf(chunk);
+                return row && static_cast<bool>(row->chunks[chunk % across]);
+            }
+
+            size_t allocatedCount() const {
+                size_t total = 0;
+                for (size_t chunk = 0; chunk < chunkCount(); ++chunk)
+                    total += allocated(chunk);
+                return total;
+            }
+
+            // Tuiles allouées que cette grille partage avec une autre
+            bool sharesChunkWith(const ChunkGrid& other, size_t chunk) const {
+                const ChunkRow *mine = rowOf(chunk);
+                const ChunkRow *theirs = other.rowOf(chunk);
+                return mine && theirs && mine->chunks[chunk % across]
+                    && mine->chunks[chunk % across].get() == theirs->chunks[chunk % across].get();
+            }
+
+            const Chunk& chunk(size_t chunk) const {
+                const ChunkRow *row = rowOf(chunk);
+                const Chunk *cells = row ? row->chunks[chunk % across].get() : nullptr;
+                return cells ? *cells : emptyChunk();
+            }
+
+            uint64_t stamp(size_t chunk) const {
+                const ChunkRow *row = rowOf(chunk);
+                return row ? row->stamps[chunk % across] : 0;
+            }
+
+            Chunk& writable(size_t chunk) {
+                return writableRow(chunk).chunks[chunk % across].write();
+            }
+
+            void setStamp(size_t chunk, uint64_t revision) {
+                writableRow(chunk).stamps[chunk % across] = revision;
+            }
+
+            const Cell& at(size_t x, size_t y) const { return chunk(chunkOf(x, y)).cells[offsetOf(x, y)]; }
+            Cell& at(size_t x, size_t y) { return writable(chunkOf(x, y)).cells[offsetOf(x, y)]; }
+    };
+
+    // Une ligne de la carte : row[x], row.size(), for (const Cell& cell : row)
+    class RowView {
+        private:
+            const ChunkGrid *grid;
+            size_t y;
+            size_t width;
+
+        public:
+            class iterator {
+                private:
+                    const ChunkGrid *grid;
+                    size_t x;
+                    size_t y;
+
+                public:
+                    iterator(const ChunkGrid *cells, size_t column, size_t line) : grid(cells), x(column), y(line) {}
+                    const Cell& operator*() const { return grid->at(x, y); }
+                    iterator& operator++() { ++x; return *this; }
+                    bool operator!=(const iterator& other) const { return x != other.x; }
+            };
+
+            RowView(const ChunkGrid *cells, size_t line, size_t rowWidth) : grid(cells), y(line), width(rowWidth) {}
+
+            const Cell& operator[](size_t x) const { return grid->at(x, y); }
+            size_t size() const { return width; }
+            bool empty() const { return width == 0; }
+            iterator begin() const { return {grid, 0, y}; }
+            iterator end() const { return {grid, width, y}; }
+    };
+
+    // Vue en lecture sur les lignes d'une grille : rows[y][x], rows.size(),
+    // et for (auto row : rows) comme avec l'ancien vector<vector<Cell>>.
+    class GridRows {
+        private:
+            const ChunkGrid *grid;
+            size_t width;
+            size_t height;
+
+        public:
+            class iterator {
+                private:
+                    const ChunkGrid *grid;
+                    size_t y;
+                    size_t width;
+
+                public:
+                    iterator(const ChunkGrid *cells, size_t line, size_t rowWidth) : grid(cells), y(line), width(rowWidth) {}
+                    RowView operator*() const { return {grid, y, width}; }
+                    iterator& operator++() { ++y; return *this; }
+                    bool operator!=(const iterator& other) const { return y != other.y; }
+            };
+
+            GridRows(const ChunkGrid *cells, size_t rowWidth, size_t rowCount) : grid(cells), width(rowWidth), height(rowCount) {}
+
+            RowView operator[](size_t y) const { return {grid, y, width}; }
+            size_t size() const { return height; }
+            bool empty() const { return height == 0; }
+            iterator begin() const { return {grid, 0, width}; }
+            iterator end() const { return {grid, height, width}; }
+    };
+
+    // Une tuile vue par forEachChunk() : origine, partie visible, contenu
+    struct MapChunk {
+        size_t index;
+        size_t x;
+        size_t y;
+        size_t width;
+        size_t height;
+        const Chunk *chunk;
+        bool allocated;
+        uint64_t stamp;
+
+        EntityType at(size_t lx, size_t ly) const { return chunk->cells[ly * CHUNK_SIZE + lx].entity; }
+    };
+
+    // Plans de bits d'une tuile (bit i = case i de la tuile) et leur compte
+    struct ChunkPlanes {
+        std::array<std::array<uint64_t, CHUNK_CELLS / 64>, ENTITY_TYPE_COUNT> bits {};
+        std::array<uint16_t, ENTITY_TYPE_COUNT> counts {};
+    };
+
+    /*
+     * Index des plans de bits par tuile, tenu à jour à la demande. C'est un
+     * cache : une copie repart vide et sera reconstruite si on l'interroge.
+     */
+    struct PlaneCache {
+        std::vector<OwnedPtr<ChunkPlanes>> chunks;
+        std::array<size_t, ENTITY_TYPE_COUNT> totals {};
+        uint64_t revision = UINT64_MAX;
+
+        PlaneCache() = default;
+        PlaneCache(const PlaneCache&) {}
+        PlaneCache& operator=(const PlaneCache&) {
+            chunks.clear();
+            revision = UINT64_MAX;
+            return *this;
+        }
+    };
+
+    // Position d'un renderer dans le journal des modifications d'une carte
+    struct ChangeCursor {
+        uint64_t lineage = 0;
+        uint64_t revision = 0;
+        uint64_t statusRevision = 0;
+    };
+
+    /*
+     * Journal des indices de cases modifiées, par blocs partagés entre une
+     * carte et ses copies. Une copie ne lit que les entrées qui existaient
+     * quand elle a été prise ; la carte d'origine continue d'écrire après,
+     * dans les mêmes blocs, sans les recopier.
+     */
+    class ChangeLog {
+        public:
+            static constexpr size_t BLOCK_SIZE = 1024;
+            static constexpr size_t BLOCK_COUNT = 64;
+            static constexpr size_t CAPACITY = BLOCK_SIZE * BLOCK_COUNT;
+
+        private:
+            using Block = std::array<uint32_t, BLOCK_SIZE>;
+            std::array<CowPtr<Block>, BLOCK_COUNT> blocks;
+            size_t count = 0;
+            // Une copie n'écrit jamais dans le bloc courant de l'original
+            bool borrowed = false;
+
+        public:
+            ChangeLog() = default;
+            ChangeLog(const ChangeLog& other) : blocks(other.blocks), count(other.count), borrowed(true) {}
+            ChangeLog& operator=(const ChangeLog& other) {
+                blocks = other.blocks;
+                count = other.count;
+                borrowed = true;
+                return *this;
+            }
+
+            size_t size() const { return count; }
+            uint32_t operator[](size_t i) const { return (*blocks[i / BLOCK_SIZE])[i % BLOCK_SIZE]; }
+
+            void push(uint32_t cell) {
+                CowPtr<Block>& block = blocks[count / BLOCK_SIZE];
+                if (borrowed) {
+                    block.write();
+                    borrowed = false;
+                }
+                block.append()[count % BLOCK_SIZE] = cell;
+                count++;
+            }
+
+            // Les copies gardent leurs blocs ; on repart sur des blocs neufs
+            void clear() {
+                for (auto& block : blocks)
+                    block.reset();
+                count = 0;
+                borrowed = false;
+            }
+    };
+
+    // Suite d'indices du journal : for (uint32_t cell : changes.cells)
+    class ChangeRange {
+        private:
+            const ChangeLog *log = nullptr;
+            size_t first = 0;
+            size_t last = 0;
+
+        public:
+            class iterator {
+                private:
+                    const ChangeLog *log;
+                    size_t i;
+
+                public:
+                    iterator(const ChangeLog *entries, size_t position) : log(entries), i(position) {}
+                    uint32_t operator*() const { return (*log)[i]; }
+                    iterator& operator++() { ++i; return *this; }
+                    bool operator!=(const iterator& other) const { return i != other.i; }
+            };
+
+            ChangeRange() = default;
+            ChangeRange(const ChangeLog *entries, size_t begin, size_t end) : log(entries), first(begin), last(end) {}
+
+            size_t size() const { return last - first; }
+            bool empty() const { return first == last; }
+            iterator begin() const { return {log, first}; }
+            iterator end() const { return {log, last}; }
+    };
+
+    // Ce qui a changé depuis un curseur : tout (full), ou seulement les
+    // cases listées ; status signale un changement de score, vies, message...
+    struct MapChanges {
+        bool full = true;
+        bool status = true;
+        ChangeRange cells;
+    };
+
+    // Chemins des images d'une carte ; partagés entre copies, rarement écrits
+    struct MapAssets {
+        std::string imagePathsDirectory;
+        std::unordered_map<EntityType, std::string> entityImagePaths = {
+            {EntityType::EMPTY,       "empty.png"},
+            {EntityType::WALL,        "wall.png"},
+            {EntityType::PLAYER,      "player.png"},
+            {EntityType::ENEMY,       "enemy.png"},
+            {EntityType::BONUS,       "bonus.png"},
+            {EntityType::BIG_BONUS,   "big_bonus.png"},
+            {EntityType::PROJECTILE,  "projectile.png"},
+            {EntityType::HIDDEN,      "hidden.png"},
+            {EntityType::BORDER,      "border.png"}
+        };
+    };
 
     class GameMap {
         protected:
             size_t level;
             size_t width;
             size_t height;
-            std::vector<std::vector<Cell>> map;
+            ChunkGrid grid;
+            // Chaque tuile garde la révision de sa dernière écriture ;
+            // stampFloor vaut pour toutes depuis le dernier markAllDirty()
+            uint64_t stampFloor = 0;
+
+            /*
+             * Journal des cases modifiées : revision compte les entrées
+             * ajoutées depuis la création, changes garde celles postérieures
+             * à logStart. Une remise à zéro, ou un journal plus long que la
+             * grille (ou que ChangeLog::CAPACITY), repart à vide et impose un rendu complet à qui est
+             * resté avant. lineage distingue deux cartes (changement de jeu) ;
+             * une copie garde celui de l'original.
+             */
+            uint64_t lineage = 0;
+            uint64_t revision = 0;
+            uint64_t logStart = 0;
+            uint64_t statusRevision = 0;
+            ChangeLog changes;
+
+            /*
+             * Un plan de bits par EntityType et par tuile allouée. Ils sont
+             * recalculés à la demande depuis le journal : un Cell* obtenu par
+             * getCell() doit donc être écrit avant la requête suivante.
+             */
+            mutable PlaneCache planes;
 
             int score = 0;
             int highScore = 0;
@@ -58,28 +623,208 @@ namespace Arcade
             int timeLeft = 0;
             std::string message = "";
             bool gameOver = false;
-            std::map<std::string, bool> flags;
-            std::string imagePathsDirectory;
-            std::unordered_map<EntityType, std::string> entityImagePaths = {
-                {EntityType::EMPTY,       "empty.png"},
-                {EntityType::WALL,        "wall.png"},
-                {EntityType::PLAYER,      "player.png"},
-                {EntityType::ENEMY,       "enemy.png"},
-                {EntityType::BONUS,       "bonus.png"},
-                {EntityType::BIG_BONUS,   "big_bonus.png"},
-                {EntityType::PROJECTILE,  "projectile.png"},
-                {EntityType::HIDDEN,      "hidden.png"},
-                {EntityType::BORDER,      "border.png"}
-            };
+            std::bitset<FlagRegistry::CAPACITY> flags;
+            // Drapeaux levés hors du registre, gardés pour les noms libres
+            std::vector<std::string> customFlags;
+            CowPtr<MapAssets> assets;
+
+            /*
+             * Couches, pour les jeux qui les utilisent (setTerrain, setItem,
+             * addActor...) : chaque écriture recompose la case de grid, que
+             * les rendus continuent de lire. Un acteur recouvre l'objet, qui
+             * recouvre le décor. terrainRevision n'avance qu'avec le décor.
+             */
+            ChunkGrid terrain;
+            ChunkGrid items;
+            CowPtr<std::vector<MapActor>> actors;
+            uint32_t nextActorId = 0;
+            uint64_t terrainRevision = 0;
 
         public:
             GameMap(size_t level, size_t width, size_t height) : level(level), width(width), height(height) {
+                lineage = static_cast<uint64_t>(std::chrono::steady_clock::now().time_since_epoch().count())
+                    ^ reinterpret_cast<uintptr_t>(this);
+                assets.write();
                 reset();
             }
 
+            // L'accès en écriture compte comme une modification de la case
             Cell* getCell(size_t x, size_t y) {
+                if (y < height && x < width) {
+                    logChange(x, y);
+                    return &grid.at(x, y);
+                }
+                return nullptr;
+            }
+
+            // N'inscrit la case au journal que si son contenu change
+            void setCell(size_t x, size_t y, EntityType type) {
+                if (y >= height || x >= width || std::as_const(grid).at(x, y).entity == type)
+                    return;
+                grid.at(x, y).entity = type;
+                logChange(x, y);
+            }
+
+            EntityType getEntity(size_t x, size_t y) const {
                 if (y < height && x < width)
-                    return &map[y][x];
+                    return grid.at(x, y).entity;
+                return EntityType::EMPTY;
+            }
+
+            // Remplit un rectangle ; les tuiles jamais écrites restent vides
+            // sans être allouées, et seules les cases changées sont journalisées.
+            void fill(size_t x0, size_t y0, size_t w, size_t h, EntityType type) {
+                const size_t x1 = std::min(width, x0 + w);
+                const size_t y1 = std::min(height, y0 + h);
+                for (size_t cy = y0; cy < y1; cy = (cy | (CHUNK_SIZE - 1)) + 1) {
+                    for (size_t cx = x0; cx < x1; cx = (cx | (CHUNK_SIZE - 1)) + 1) {
+                        const size_t chunk = grid.chunkOf(cx, cy);
+                        if (type == EntityType::EMPTY && !grid.allocated(chunk))
+                            continue;
+                        const size_t yEnd = std::min(y1, (cy | (CHUNK_SIZE - 1)) + 1);
+                        const size_t xEnd = std::min(x1, (cx | (CHUNK_SIZE - 1)) + 1);
+                        // Lignes entières de la tuile : une seule plage contiguë
+                        if (xEnd - cx == CHUNK_SIZE)
+                            fillSpan(chunk, ChunkGrid::offsetOf(cx, cy), (yEnd - cy) * CHUNK_SIZE, type);
+                        else
+                            for (size_t y = cy; y < yEnd; ++y)
+                                fillSpan(chunk, ChunkGrid::offsetOf(cx, y), xEnd - cx, type);
+                    }
+                }
+            }
+
+            // Remplace toutes les cases from par to, en ne lisant que les
+            // tuiles dont le plan de from n'est pas vide
+            void replace(EntityType from, EntityType to) {
+                if (from == to)
+                    return;
+                syncPlanes();
+                const auto slot = static_cast<size_t>(from);
+                for (size_t c = 0; c < grid.chunkCount(); ++c) {
+                    if (!planes.chunks[c]) {
+                        if (from == EntityType::EMPTY)
+                            fill(grid.originX(c), grid.originY(c), grid.visibleWidth(c), grid.visibleHeight(c), to);
+                        continue;
+                    }
+                    if (planes.chunks[c]->counts[slot] == 0)
+                        continue;
+                    const auto bits = planes.chunks[c]->bits[slot];
+                    for (size_t word = 0; word < bits.size(); ++word) {
+                        for (uint64_t rest = bits[word]; rest; rest &= rest - 1) {
+                            const size_t offset = word * 64 + static_cast<size_t>(std::countr_zero(rest));
+                            setCell(grid.originX(c) + (offset & (CHUNK_SIZE - 1)), grid.originY(c) + (offset >> CHUNK_SHIFT), to);
+                        }
+                    }
+                }
+            }
+
+            /*
+             * Indices (y * largeur + x) des cases qui diffèrent de other, de
+             * même taille, tuile par tuile. Les tuiles encore partagées (copie,
+             * instantané) ou vides des deux côtés ne sont pas lues.
+             */
+            std::vector<uint32_t> diff(const GameMap& other) const {
+                if (other.width != width || other.height != height)
+                    throw std::runtime_error("Cannot diff maps of different sizes");
+                std::vector<uint32_t> dirty;
+                std::vector<uint32_t> offsets;
+                const auto& kernels = kernels::active();
+                for (size_t c = 0; c < grid.chunkCount(); ++c) {
+                    const Chunk& mine = grid.chunk(c);
+                    const Chunk& theirs = other.grid.chunk(c);
+                    if (&mine == &theirs)
+                        continue;
+                    offsets.clear();
+                    kernels.diff(bytesOf(mine), bytesOf(theirs), CHUNK_CELLS, 0, offsets);
+                    for (const uint32_t offset : offsets)
+                        dirty.push_back(static_cast<uint32_t>(index(grid.originX(c) + (offset & (CHUNK_SIZE - 1)),
+                            grid.originY(c) + (offset >> CHUNK_SHIFT))));
+                }
+                return dirty;
+            }
+
+            void markDirty(size_t cell) {
+                logChange(cell % width, cell / width);
+            }
+
+            void markAllDirty() {
+                changes.clear();
+                revision++;
+                logStart = revision;
+                stampFloor = revision;
+            }
+
+            uint64_t getRevision() const {
+                return revision;
+            }
+
+            bool has(EntityType type, size_t x, size_t y) const {
+                if (y >= height || x >= width)
+                    return false;
+                syncPlanes();
+                const ChunkPlanes *chunk = planes.chunks[grid.chunkOf(x, y)].get();
+                if (!chunk)
+                    return type == EntityType::EMPTY;
+                const size_t offset = ChunkGrid::offsetOf(x, y);
+                return (chunk->bits[static_cast<size_t>(type)][offset / 64] >> (offset % 64)) & 1;
+            }
+
+            size_t count(EntityType type) const {
+                syncPlanes();
+                return planes.totals[static_cast<size_t>(type)];
+            }
+
+            // Indice (y * largeur + x) de la n-ième case (à partir de 0)
+            // contenant type, tuile après tuile, ou getWidth() * getHeight()
+            // s'il y en a moins de n + 1.
+            size_t nth(EntityType type, size_t n) const {
+                syncPlanes();
+                const auto slot = static_cast<size_t>(type);
+                for (size_t c = 0; c < grid.chunkCount(); ++c) {
+                    const ChunkPlanes *chunk = planes.chunks[c].get();
+                    const size_t visibleWidth = grid.visibleWidth(c);
+                    const size_t inChunk = chunk ? chunk->counts[slot]
+                        : (type == EntityType::EMPTY ? visibleWidth * grid.visibleHeight(c) : 0);
+                    if (n >= inChunk) {
+                        n -= inChunk;
+                        continue;
+                    }
+                    size_t lx = n % visibleWidth;
+                    size_t ly = n / visibleWidth;
+                    if (chunk) {
+                        for (size_t word = 0; word < chunk->bits[slot].size(); ++word) {
+                            uint64_t value = chunk->bits[slot][word];
+                            const auto inWord = static_cast<size_t>(std::popcount(value));
+                            if (n >= inWord) {
+                                n -= inWord;
+                                continue;
+                            }
+                            for (; n > 0; --n)
+                                value &= value - 1;
+                            const size_t offset = word * 64 + static_cast<size_t>(std::countr_zero(value));
+                            lx = offset & (CHUNK_SIZE - 1);
+                            ly = offset >> CHUNK_SHIFT;
+                            break;
+                        }
+                    }
+                    return index(grid.originX(c) + lx, grid.originY(c) + ly);
+                }
+                return width * height;
+            }
+
+            MapChanges changesSince(ChangeCursor& cursor) const {
+                MapChanges result;
+                result.full = cursor.lineage != lineage || cursor.revision < logStart || cursor.revision > revision;
+                result.status = result.full || cursor.statusRevision != statusRevision;
+                if (!result.full)
+                    result.cells = ChangeRange(&changes, cursor.revision - logStart, changes.size());
+                cursor = {lineage, revision, statusRevision};
+                return result;
+            }
+
+            const Cell* getCell(size_t x, size_t y) const {
+                if (y < height && x < width)
+                    return &grid.at(x, y);
                 return nullptr;
             }
 
@@ -91,37 +836,243 @@ namespace Arcade
                 return width;
             }
 
-            const std::vector<std::vector<Cell>>& getCell() const {
-                return map;
+            GridRows getCell() const {
+                return {&grid, width, height};
+            }
+
+            size_t index(size_t x, size_t y) const {
+                return y * width + x;
+            }
+
+            size_t chunkCount() const {
+                return grid.chunkCount();
+            }
+
+            size_t allocatedChunks() const {
+                return grid.allocatedCount();
+            }
+
+            // Visite chaque tuile, ligne de tuiles après ligne de tuiles
+            template <typename Visitor>
+            void forEachChunk(Visitor&& visit) const {
+                for (size_t c = 0; c < grid.chunkCount(); ++c)
+                    visit(describeChunk(c));
+            }
+
+            // Seulement les tuiles écrites après la révision donnée
+            // (getRevision() ou ChangeCursor::revision d'une image précédente)
+            template <typename Visitor>
+            void forEachChunkChangedSince(uint64_t since, Visitor&& visit) const {
+                for (size_t c = 0; c < grid.chunkCount(); ++c) {
+                    if (std::max(grid.stamp(c), stampFloor) > since)
+                        visit(describeChunk(c));
+                }
             }
 
             void reset()
             {
-                map.clear();
-                map.resize(height, std::vector<Cell>(width));
+                grid.reshape(width, height);
+                terrain.reshape(width, height);
+                items.reshape(width, height);
+                actors.reset();
+                terrainRevision++;
+                markAllDirty();
+            }
+
+            // Redimensionne la carte, vide
+            void reshape(size_t newWidth, size_t newHeight)
+            {
+                width = newWidth;
+                height = newHeight;
+                reset();
+            }
+
+            // Reprend la grille d'une autre carte (niveau mis en cache) ; les
+            // tuiles restent partagées jusqu'à leur première écriture
+            void restore(const GameMap& source)
+            {
+                width = source.width;
+                height = source.height;
+                grid = source.grid;
+                terrain = source.terrain;
+                items = source.items;
+                actors = source.actors;
+                nextActorId = source.nextActorId;
+                terrainRevision = std::max(terrainRevision, source.terrainRevision) + 1;
+                markAllDirty();
+            }
+
+            // Reprend tout l'état d'une image antérieure ; la lignée et les
+            // révisions restent celles de cette carte pour que les curseurs
+            // des rendus voient un redessin complet et non un retour en arrière
+            void rewind(const GameMap& frame)
+            {
+                const uint64_t ownLineage = lineage;
+                const uint64_t lastRevision = std::max(revision, frame.revision);
+                const uint64_t lastStatus = std::max(statusRevision, frame.statusRevision);
+                const uint64_t lastTerrain = std::max(terrainRevision, frame.terrainRevision);
+                *this = frame;
+                lineage = ownLineage;
+                revision = lastRevision;
+                statusRevision = lastStatus + 1;
+                terrainRevision = lastTerrain + 1;
+                markAllDirty();
+            }
+
+            EntityType getTerrain(size_t x, size_t y) const {
+                return y < height && x < width ? terrain.at(x, y).entity : EntityType::EMPTY;
+            }
+
+            EntityType getItem(size_t x, size_t y) const {
+                return y < height && x < width ? items.at(x, y).entity : EntityType::EMPTY;
+            }
+
+            const std::vector<MapActor>& getActors() const {
+                static const std::vector<MapActor> none;
+                return actors ? *actors : none;
+            }
+
+            // Change à chaque écriture du décor : un rendu peut garder le
+            // décor dessiné tant qu'elle ne bouge pas
+            uint64_t getTerrainRevision() const {
+                return terrainRevision;
+            }
+
+            void setTerrain(size_t x, size_t y, EntityType type) {
+                if (y >= height || x >= width || std::as_const(terrain).at(x, y).entity == type)
+                    return;
+                terrain.at(x, y).entity = type;
+                terrainRevision++;
+                compose(x, y);
+            }
+
+            void setItem(size_t x, size_t y, EntityType type) {
+                if (y >= height || x >= width || std::as_const(items).at(x, y).entity == type)
+                    return;
+                items.at(x, y).entity = type;
+                compose(x, y);
+            }
+
+            uint32_t addActor(size_t x, size_t y, EntityType type) {
+                const uint32_t id = nextActorId++;
+                actors.write().push_back({id, static_cast<uint32_t>(x), static_cast<uint32_t>(y), type});
+                compose(x, y);
+                return id;
+            }
+
+            // Objets de ce type, visibles ou recouverts par un acteur
+            size_t countItems(EntityType type) const {
+                size_t total = count(type);
+                const auto& list = getActors();
+                for (size_t i = 0; i < list.size(); ++i) {
+                    const MapActor& actor = list[i];
+                    const bool seen = std::any_of(list.begin(), list.begin() + static_cast<std::ptrdiff_t>(i),
+                        [&actor](const MapActor& other) { return other.x == actor.x && other.y == actor.y; });
+                    if (!seen && getItem(actor.x, actor.y) == type && getEntity(actor.x, actor.y) != type)
+                        total++;
+                }
+                return total;
+            }
+
+            const MapActor *findActor(uint32_t id) const {
+                for (const MapActor& actor : getActors()) {
+                    if (actor.id == id)
+                        return &actor;
+                }
+                return nullptr;
+            }
+
+            // Déplace un acteur ; seules ses deux cases sont recomposées
+            void moveActor(uint32_t id, size_t x, size_t y) {
+                MapActor *actor = writableActor(id);
+                if (!actor || (actor->x == x && actor->y == y))
+                    return;
+                const size_t fromX = actor->x;
+                const size_t fromY = actor->y;
+                actor->x = static_cast<uint32_t>(x);
+                actor->y = static_cast<uint32_t>(y);
+                compose(fromX, fromY);
+                compose(x, y);
+            }
 
+            void setActorEntity(uint32_t id, EntityType type) {
+                MapActor *actor = writableActor(id);
+                if (!actor || actor->entity == type)
+                    return;
+                actor->entity = type;
+                compose(actor->x, actor->y);
+            }
+
+            void removeActor(uint32_t id) {
+                const MapActor *actor = findActor(id);
+                if (!actor)
+                    return;
+                const size_t x = actor->x;
+                const size_t y = actor->y;
+                const auto index = actor - getActors().data();
+                auto& list = actors.write();
+                list.erase(list.begin() + index);
+                compose(x, y);
+            }
+
+            void clearActors() {
+                const std::vector<MapActor> gone = getActors();
+                actors.reset();
+                for (const MapActor& actor : gone)
+                    compose(actor.x, actor.y);
+            }
+
+            /*
+             * Répartit la grille plate (chargée d'une carte texte) entre les
+             * couches : murs et vides dans le décor, gommes dans les objets.
+             * Les cases d'acteurs deviennent vides ; c'est au jeu de placer ses
+             * acteurs (points d'apparition du niveau).
+             */
+            void splitLayers() {
+                terrain.reshape(width, height);
+                items.reshape(width, height);
+                actors.reset();
                 for (size_t y = 0; y < height; ++y) {
                     for (size_t x = 0; x < width; ++x) {
-                        map[y][x] = Cell(x, y, EntityType::EMPTY);
+                        const EntityType type = getEntity(x, y);
+                        if (type == EntityType::EMPTY)
+                            continue;
+                        if (layerOf(type) == MapLayer::TERRAIN)
+                            terrain.at(x, y).entity = type;
+                        else if (layerOf(type) == MapLayer::ITEMS)
+                            items.at(x, y).entity = type;
+                        else
+                            setCell(x, y, EntityType::EMPTY);
                     }
                 }
+                terrainRevision++;
+            }
+
+            // Tuiles allouées encore partagées avec other (copie, instantané)
+            size_t sharedChunks(const GameMap& other) const {
+                size_t total = 0;
+                if (other.width != width || other.height != height)
+                    return 0;
+                for (size_t c = 0; c < grid.chunkCount(); ++c)
+                    total += grid.sharesChunkWith(other.grid, c);
+                return total;
             }
 
             void setImagePathsDirectory(const std::string& path) {
-                imagePathsDirectory = path;
+                assets.write().imagePathsDirectory = path;
             }
 
-            std::string getImagePathsDirectory() {
-                return imagePathsDirectory;
+            std::string getImagePathsDirectory() const {
+                return assets->imagePathsDirectory;
             }
 
             void setEntityImagePath(EntityType type, const std::string& path) {
-                entityImagePaths[type] = path;
+                assets.write().entityImagePaths[type] = path;
             }
     
             std::string getEntityImagePath(EntityType type) const {
-                const auto it = entityImagePaths.find(type);
-                if (it != entityImagePaths.end())
+                const auto it = assets->entityImagePaths.find(type);
+                if (it != assets->entityImagePaths.end())
                     return it->second;
                 return "";
             }
@@ -137,93 +1088,72 @@ namespace Arcade
                 std::cout << "chargement de la carte depuis le fichier: " << filepath << std::endl;
                 if (!file.is_open()) throw std::runtime_error("Impossible d'ouvrir le fichier de la map.");
 
-                map.clear();
+                std::vector<std::string> lines;
                 std::string line;
-                size_t y = 0;
                 size_t maxWidth = 0;
                 while (std::getline(file, line)) {
-                    std::vector<Cell> row;
-                    for (size_t x = 0; x < line.size(); ++x) {
-                        auto type = EntityType::EMPTY;
-                        switch (line[x]) {
-                            case '#': type = EntityType::WALL; break;
-                            case 'P': type = EntityType::PLAYER; break;
-                            case 'E': type = EntityType::ENEMY; break;
-                            case 'B': type = EntityType::BONUS; break;
-                            case 'X': type = EntityType::PROJECTILE; break;
-                            case '?': type = EntityType::HIDDEN; break;
-                            case '|': type = EntityType::BORDER; break;
-                            default:  type = EntityType::EMPTY; break;
-                        }
-                        row.emplace_back(x, y, type);
-                    }
-                    if (row.size() > maxWidth)
-                        maxWidth = row.size();
-                    map.push_back(row);
-                    y++;
+                    maxWidth = std::max(maxWidth, line.size());
+                    lines.push_back(line);
+                }
+
+                // Les lignes courtes sont complétées par des cases vides
+                reshape(maxWidth, lines.size());
+                for (size_t y = 0; y < height; ++y) {
+                    for (size_t x = 0; x < lines[y].size(); ++x)
+                        setCell(x, y, entityFromSymbol(lines[y][x]));
                 }
-                height = map.size();
-                width = maxWidth;
             }
 
             void afficherMap() const
             {
-                for (const auto& row : map) {
-                    for (const auto& cell : row) {
-                        char symbol = ' ';
-                        switch (cell.entity) {
-                            case EntityType::EMPTY:       symbol = ' '; break;
-                            case EntityType::WALL:        symbol = '#'; break;
-                            case EntityType::PLAYER:      symbol = 'P'; break;
-                            case EntityType::ENEMY:       symbol = 'E'; break;
-                            case EntityType::BONUS:       symbol = 'B'; break;
-                            case EntityType::BIG_BONUS:   symbol = 'O'; break;
-                            case EntityType::PROJECTILE:  symbol = 'X'; break;
-                            case EntityType::HIDDEN:      symbol = '?'; break;
-                            case EntityType::BORDER:      symbol = '|'; break;
-                            default:                      symbol = '.'; break;
-                        }
-                        std::cout << symbol;
-                    }
+                for (const auto row : getCell()) {
+                    for (const auto& cell : row)
+                        std::cout << symbolOf(cell.entity);
                     std::cout << std::endl;
                 }
             }
 
             bool hasScore() const { return score > 0; }
             size_t getScore() const { return score; }
-            void setScore(int _score) { score = _score; }
+            void setScore(int _score) { updateStatus(score, _score); }
 
             bool hasHighScore() const { return highScore > 0; }
             int getHighScore() const { return highScore; }
-            void setHighScore(int _highScore) { highScore = _highScore; }
+            void setHighScore(int _highScore) { updateStatus(highScore, _highScore); }
 
             bool hasLevel() const { return true; }
             size_t getLevel() const { return level; }
-            void setLevel(size_t _level) { level = _level; }
+            void setLevel(size_t _level) { updateStatus(level, _level); }
 
             bool hasLives() const { return lives > 0; }
             size_t getLives() const { return lives; }
-            void setLives(int _lives) { lives = _lives; }
+            void setLives(int _lives) { updateStatus(lives, _lives); }
 
             bool hasTimeLeft() const { return timeLeft > 0; }
             int getTimeLeft() const { return timeLeft; }
-            void setTimeLeft(int _timeLeft) { timeLeft = _timeLeft; }
+            void setTimeLeft(int _timeLeft) { updateStatus(timeLeft, _timeLeft); }
 
             bool hasMessage() const { return !message.empty(); }
             std::string getMessage() const { return message; }
-            void setMessage(const std::string& _message) { message = _message; }
+            void setMessage(const std::string& _message) { updateStatus(message, _message); }
 
             bool isGameOver() const { return gameOver; }
-            void setGameOver(bool _gameOver) { gameOver = _gameOver; }
+            void setGameOver(bool _gameOver) { updateStatus(gameOver, _gameOver); }
+
+            bool hasFlag(MapFlag flag) const {
+                return flags.test(static_cast<size_t>(flag));
+            }
 
-            bool hasFlag(const std::string& flag) const {
-                auto it = flags.find(flag);
-                return it != flags.end() && it->second;
+            bool hasFlag(std::string_view flag) const {
+                const size_t id = FlagRegistry::find(flag);
+                if (id < FlagRegistry::CAPACITY)
+                    return flags.test(id);
+                return std::find(customFlags.begin(), customFlags.end(), flag) != customFlags.end();
             }
 
             void decrementLife() {
                 if (lives > 0) {
-                    lives--;
+                    setLives(lives - 1);
                     if (lives <= 0) {
                         setGameOver(true);
                     }
@@ -231,15 +1161,208 @@ namespace Arcade
             }
             
             
-            void setFlag(const std::string& flag, bool value = true) { flags[flag] = value; }
+            void setFlag(MapFlag flag, bool value = true) {
+                const auto id = static_cast<size_t>(flag);
+                if (flags.test(id) == value)
+                    return;
+                flags.set(id, value);
+                statusRevision++;
+            }
+
+            void setFlag(std::string_view flag, bool value = true) {
+                const size_t id = FlagRegistry::find(flag);
+                if (id < FlagRegistry::CAPACITY) {
+                    setFlag(static_cast<MapFlag>(id), value);
+                    return;
+                }
+                const auto it = std::find(customFlags.begin(), customFlags.end(), flag);
+                if ((it != customFlags.end()) == value)
+                    return;
+                if (value)
+                    customFlags.emplace_back(flag);
+                else
+                    customFlags.erase(it);
+                statusRevision++;
+            }
 
             void setScore(size_t score) {
-                this->score = score;
+                updateStatus(this->score, static_cast<int>(score));
             }
     
             void setLives(size_t lives)
             {
-                this->lives = lives;
+                updateStatus(this->lives, static_cast<int>(lives));
+            }
+
+        private:
+            MapActor *writableActor(uint32_t id) {
+                if (!findActor(id))
+                    return nullptr;
+                for (MapActor& actor : actors.write()) {
+                    if (actor.id == id)
+                        return &actor;
+                }
+                return nullptr;
+            }
+
+            // Case visible = dernier acteur posé dessus, sinon objet, sinon décor
+            void compose(size_t x, size_t y) {
+                if (y >= height || x >= width)
+                    return;
+                const auto& list = getActors();
+                for (auto actor = list.rbegin(); actor != list.rend(); ++actor) {
+                    if (actor->x == x && actor->y == y) {
+                        setCell(x, y, actor->entity);
+                        return;
+                    }
+                }
+                const EntityType item = std::as_const(items).at(x, y).entity;
+                setCell(x, y, item != EntityType::EMPTY ? item : std::as_const(terrain).at(x, y).entity);
+            }
+
+            void logChange(size_t x, size_t y) {
+                if (changes.size() >= std::min(width * height, ChangeLog::CAPACITY)) {
+                    changes.clear();
+                    logStart = revision;
+                }
+                changes.push(static_cast<uint32_t>(index(x, y)));
+                revision++;
+                grid.setStamp(grid.chunkOf(x, y), revision);
+            }
+
+            MapChunk describeChunk(size_t c) const {
+                return {c, grid.originX(c), grid.originY(c), grid.visibleWidth(c), grid.visibleHeight(c),
+                    &grid.chunk(c), grid.allocated(c), std::max(grid.stamp(c), stampFloor)};
+            }
+
+            // Cases de la tuile dans la carte, les autres restant vides
+            std::array<uint64_t, CHUNK_CELLS / 64> visibleMask(size_t c) const {
+                std::array<uint64_t, CHUNK_CELLS / 64> mask {};
+                const size_t visible = grid.visibleWidth(c);
+                const uint64_t row = visible == CHUNK_SIZE ? UINT32_MAX : (uint64_t {1} << visible) - 1;
+                for (size_t ly = 0; ly < grid.visibleHeight(c); ++ly)
+                    mask[ly / 2] |= row << ((ly % 2) * CHUNK_SIZE);
+                return mask;
+            }
+
+            void buildPlanes(size_t c) const {
+                ChunkPlanes& chunk = planes.chunks[c].emplace();
+                const uint8_t *cells = bytesOf(grid.chunk(c));
+                const bool edge = grid.visibleWidth(c) < CHUNK_SIZE || grid.visibleHeight(c) < CHUNK_SIZE;
+                const auto mask = edge ? visibleMask(c) : std::array<uint64_t, CHUNK_CELLS / 64> {};
+                const auto& kernels = kernels::active();
+                for (size_t slot = 0; slot < ENTITY_TYPE_COUNT; ++slot) {
+                    kernels.matchBits(cells, CHUNK_CELLS, static_cast<uint8_t>(slot), chunk.bits[slot].data());
+                    size_t total = 0;
+                    for (size_t word = 0; word < CHUNK_CELLS / 64; ++word) {
+                        if (edge)
+                            chunk.bits[slot][word] &= mask[word];
+                        total += static_cast<size_t>(std::popcount(chunk.bits[slot][word]));
+                    }
+                    chunk.counts[slot] = static_cast<uint16_t>(total);
+                    planes.totals[slot] += total;
+                }
+            }
+
+            // Écrit type sur une plage contiguë de la tuile, en ne journalisant
+            // que les cases qui changent ; la tuile n'est recopiée que s'il y en a
+            void fillSpan(size_t c, size_t offset, size_t length, EntityType type) {
+                static thread_local std::vector<uint32_t> dirty;
+                static thread_local std::array<uint8_t, CHUNK_CELLS> pattern;
+                const auto& kernels = kernels::active();
+                const auto value = static_cast<uint8_t>(type);
+                kernels.fill(pattern.data(), length, value);
+                dirty.clear();
+                kernels.diff(bytesOf(grid.chunk(c)) + offset, pattern.data(), length, static_cast<uint32_t>(offset), dirty);
+                if (dirty.empty())
+                    return;
+                Chunk& cells = grid.writable(c);
+                const bool whole = dirty.size() == length;
+                if (whole)
+                    kernels.fill(bytesOf(cells) + offset, length, value);
+                const size_t x0 = grid.originX(c);
+                const size_t y0 = grid.originY(c);
+                for (const uint32_t local : dirty) {
+                    if (!whole)
+                        cells.cells[local].entity = type;
+                    logChange(x0 + (local & (CHUNK_SIZE - 1)), y0 + (local >> CHUNK_SHIFT));
+                }
+            }
+
+            void syncPlanes() const {
+                if (planes.revision == revision)
+                    return;
+                const auto empty = static_cast<size_t>(EntityType::EMPTY);
+                if (planes.revision < logStart || planes.revision > revision || planes.chunks.size() != grid.chunkCount()) {
+                    planes.chunks.assign(grid.chunkCount(), {});
+                    planes.totals.fill(0);
+                    for (size_t c = 0; c < grid.chunkCount(); ++c) {
+                        if (grid.allocated(c))
+                            buildPlanes(c);
+                        else
+                            planes.totals[empty] += grid.visibleWidth(c) * grid.visibleHeight(c);
+                    }
+                } else {
+                    for (size_t i = planes.revision - logStart; i < changes.size(); ++i) {
+                        const size_t x = changes[i] % width;
+                        const size_t y = changes[i] / width;
+                        const size_t c = grid.chunkOf(x, y);
+                        if (!planes.chunks[c]) {
+                            // La tuile était encore entièrement vide
+                            planes.totals[empty] -= grid.visibleWidth(c) * grid.visibleHeight(c);
+                            buildPlanes(c);
+                            continue;
+                        }
+                        ChunkPlanes& chunk = *planes.chunks[c];
+                        const size_t offset = ChunkGrid::offsetOf(x, y);
+                        const uint64_t bit = uint64_t {1} << (offset % 64);
+                        const auto now = static_cast<size_t>(grid.at(x, y).entity);
+                        if (chunk.bits[now][offset / 64] & bit)
+                            continue;
+                        for (size_t slot = 0; slot < ENTITY_TYPE_COUNT; ++slot) {
+                            if (chunk.bits[slot][offset / 64] & bit) {
+                                chunk.bits[slot][offset / 64] &= ~bit;
+                                chunk.counts[slot]--;
+                                planes.totals[slot]--;
+                            }
+                        }
+                        chunk.bits[now][offset / 64] |= bit;
+                        chunk.counts[now]++;
+                        planes.totals[now]++;
+                    }
+                }
+                planes.revision = revision;
+            }
+
+            template <typename T>
+            void updateStatus(T& field, const T& value) {
+                if (field == value)
+                    return;
+                field = value;
+                statusRevision++;
+            }
+    };
+
+    /*
+     * Image figée d'une carte, pour le replay, le retour arrière ou un rendu
+     * sur un autre thread. La prendre ne copie que des pointeurs : les tuiles,
+     * le journal et les chemins d'images restent partagés avec la carte, qui
+     * ne recopie une tuile qu'au moment où elle y écrit. Garder une image par
+     * tick ne coûte donc que les tuiles modifiées entre deux ticks.
+     */
+    class MapSnapshot {
+        private:
+            GameMap frame;
+
+        public:
+            explicit MapSnapshot(const GameMap& map) : frame(map) {}
+
+            const GameMap& view() const { return frame; }
+            const GameMap *operator->() const { return &frame; }
+
+            // Revient à cette image ; la carte repart en redessin complet
+            void restoreInto(GameMap& map) const {
+                map.rewind(frame);
             }
     };
 }
@@ -273,22 +1396,35 @@ Un `enum class` permettant de catégoriser les types d'entités possibles sur la
 | `BORDER`    | Bordure spécifique (Qix)                 |
 
 ### 3.2. `Cell`
-Une structure représentant une case de la carte avec :
-- **Coordonnées (`x, y`)** : Position de la cellule dans la grille.
+Une structure d'un octet représentant une case de la carte :
 - **Type d'entité (`entity`)** : Contenu de la cellule sous forme d'un `EntityType`.
+- La position n'est pas stockée : elle découle de la tuile et de la place de la case dans celle-ci.
 
 ### 3.3. `GameMap`
 Une classe qui stocke et gère la carte du jeu :
 - **Attributs :**
   - `size_t level` : Niveau actuel du jeu.
   - `size_t width, height` : Dimensions de la carte.
-  - `std::vector<std::vector<Cell>> map` : Grille contenant les cellules.
+  - `ChunkGrid grid` : Grille découpée en tuiles de `CHUNK_SIZE` x `CHUNK_SIZE` cases, allouées à la première écriture ; une tuile jamais écrite se lit comme vide.
 
 - **Méthodes :**
   - `GameMap(size_t level, size_t width, size_t height)` : Constructeur initialisant la carte avec une taille spécifique.
   - `Cell* getCell(int x, int y)` : Retourne un pointeur vers la cellule aux coordonnées `(x, y)` si elle est valide, sinon `nullptr`.
+  - `GridRows getCell()` : Vue en lecture des lignes (`rows[y][x]`, `rows.size()`).
+  - `void fill(x, y, w, h, type)` : Remplit un rectangle sans allouer les tuiles vides qu'il laisse vides ; seules les cases qui changent sont écrites et journalisées.
+  - `void replace(from, to)` : Remplace toutes les cases d'un type, guidé par les plans de bits.
+  - `std::vector<uint32_t> diff(const GameMap& other)` : Indices des cases qui diffèrent d'une carte de même taille ; les tuiles partagées ne sont pas lues.
+  - Les parcours en bloc (remplissage, plans de bits, comparaison) passent par les noyaux de `gridKernels.hpp` (AVX2, SSE2 ou scalaire, choisi à l'exécution).
+  - `forEachChunk(visit)` / `forEachChunkChangedSince(revision, visit)` : Parcours des tuiles (`MapChunk`), éventuellement limité à celles écrites depuis une révision.
+  - `size_t index(size_t x, size_t y)` : Indice `y * largeur + x` de la case, utilisé par le journal et `nth()`.
+  - `has(type, x, y)`, `count(type)`, `nth(type, n)` : Requêtes sur les plans de bits tenus par type d'entité et par tuile.
   - `void reset()` : Réinitialise la carte avec des cellules vides (`EntityType::EMPTY`).
-  - `void chargeMap(const std::string& filepath)` : Charge une carte depuis un fichier texte en associant les caractères aux entités correspondantes.
+  - `void chargeMap(const std::string& filepath)` : Charge une carte depuis un fichier texte en associant les caractères aux entités correspondantes (`entityFromSymbol`).
+  - `void restore(const GameMap& source)` : Reprend la grille d'une autre carte.
+  - `void reshape(size_t width, size_t height)` : Redimensionne la carte, vide.
+  - Copier une `GameMap` (ou en prendre un `MapSnapshot`) est en O(1) : lignes de tuiles, tuiles, journal et chemins d'images sont comptés par référence (`CowPtr`) et ne sont recopiés qu'à la première écriture.
+  - Couches (`MapLayer`) : `setTerrain`, `setItem`, `addActor` / `moveActor` / `removeActor` écrivent le décor, les objets et la liste clairsemée des acteurs (`MapActor`) ; la grille lue par les rendus est leur superposition, recomposée case par case. `splitLayers()` répartit une carte plate entre les couches ; `getTerrainRevision()` permet de garder le décor en cache.
+  - `setFlag(MapFlag, bool)` / `hasFlag(MapFlag)` : Drapeaux d'état (`VICTORY`, `PAUSED`) rangés dans un bitset ; les surcharges prenant un nom passent par `FlagRegistry::find()` et gardent les noms inconnus à part.
 
 ## 4. Fonctionnement Global
 1. **Initialisation** : Lorsqu'un jeu commence, une instance de `GameMap` est créée avec une taille définie.
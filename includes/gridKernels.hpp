@@ -0,0 +1,369 @@
+/*
+**  _                                              _      ___    ___
+** | |                                            | |    |__ \  / _ \
+** | |_Created _       _ __   _ __    ___    __ _ | |__     ) || (_) |
+** | '_ \ | | | |     | '_ \ | '_ \  / _ \  / _` || '_ \   / /  \__, |
+** | |_) || |_| |     | | | || | | || (_) || (_| || | | | / /_    / /
+** |_.__/  \__, |     |_| |_||_| |_| \___/  \__,_||_| |_||____|  /_/
+**          __/ |     on 18/10/26.
+**         |___/
+*/
+
+#ifndef GRIDKERNELS_HPP
+#define GRIDKERNELS_HPP
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <string_view>
+#include <vector>
+
+#if defined(__x86_64__) || defined(__i386__)
+    #include <immintrin.h>
+    #define ARCADE_KERNELS_X86 1
+#endif
+
+/*
+ * Opérations en bloc sur des cases contiguës (une tuile de GameMap, ou
+ * n'importe quel tableau d'octets), une case par octet. Trois versions,
+ * choisies une fois par module au premier appel de kernels::active() :
+ * AVX2 si le processeur l'a, SSE2 sinon sur x86, scalaire ailleurs.
+ * ARCADE_SIMD=scalar|sse2|avx2 force un choix (dans la limite du processeur).
+ *
+ * Toutes les versions rendent exactement le même résultat, checksum()
+ * compris : une empreinte enregistrée sur une machine se vérifie sur une autre.
+ */
+namespace Arcade
+{
+    namespace kernels
+    {
+        // Types comptés par countByType(), un par EntityType
+        inline constexpr size_t TYPE_COUNT = 11;
+
+        struct Table {
+            const char *name;
+            // dst[0..n) = value
+            void (*fill)(uint8_t *dst, size_t n, uint8_t value);
+            // counts[v] += nombre de cases valant v, pour v < TYPE_COUNT
+            void (*countByType)(const uint8_t *src, size_t n, uint32_t *counts);
+            // bit i de bits[i / 64] = (src[i] == value) ; n multiple de 64
+            void (*matchBits)(const uint8_t *src, size_t n, uint8_t value, uint64_t *bits);
+            // Ajoute base + i à dirty pour chaque i où a[i] != b[i]
+            void (*diff)(const uint8_t *a, const uint8_t *b, size_t n, uint32_t base, std::vector<uint32_t>& dirty);
+            // Empreinte 64 bits, identique d'une version à l'autre
+            uint64_t (*checksum)(const uint8_t *src, size_t n, uint64_t seed);
+        };
+
+        namespace detail
+        {
+            // Huit voies de 32 bits, une tournée xxHash32 par mot de 4 octets
+            inline constexpr uint32_t PRIME1 = 0x9E3779B1u;
+            inline constexpr uint32_t PRIME2 = 0x85EBCA77u;
+            inline constexpr uint32_t PRIME3 = 0xC2B2AE3Du;
+            inline constexpr uint64_t FOLD_PRIME = 0x100000001b3ULL;
+            inline constexpr size_t LANES = 8;
+            inline constexpr size_t STRIPE = LANES * sizeof(uint32_t);
+
+            inline uint32_t round(uint32_t acc, uint32_t word)
+            {
+                return std::rotl(acc + word * PRIME2, 13) * PRIME1;
+            }
+
+            inline void seedLanes(uint32_t *lanes, uint64_t seed)
+            {
+                for (size_t j = 0; j < LANES; ++j)
+                    lanes[j] = static_cast<uint32_t>(seed) + PRIME3 * static_cast<uint32_t>(j + 1);
+            }
+
+            // Replie les voies, puis la fin (moins d'une bande) octet par octet
+            inline uint64_t finish(const uint32_t *lanes, const uint8_t *tail, size_t rest, size_t n, uint64_t seed)
+            {
+                uint64_t hash = seed ^ n;
+                for (size_t j = 0; j < LANES; ++j)
+                    hash = (hash ^ lanes[j]) * FOLD_PRIME;
+                for (size_t i = 0; i < rest; ++i)
+                    hash = (hash ^ tail[i]) * FOLD_PRIME;
+                hash ^= hash >> 33;
+                hash *= 0xff51afd7ed558ccdULL;
+                hash ^= hash >> 33;
+                return hash;
+            }
+
+            inline void pushMask(uint32_t mask, uint32_t base, std::vector<uint32_t>& dirty)
+            {
+                while (mask) {
+                    dirty.push_back(base + static_cast<uint32_t>(std::countr_zero(mask)));
+                    mask &= mask - 1;
+                }
+            }
+        }
+
+        namespace scalar
+        {
+            inline void fill(uint8_t *dst, size_t n, uint8_t value)
+            {
+                std::memset(dst, value, n);
+            }
+
+            inline void countByType(const uint8_t *src, size_t n, uint32_t *counts)
+            {
+                for (size_t i = 0; i < n; ++i) {
+                    if (src[i] < TYPE_COUNT)
+                        counts[src[i]]++;
+                }
+            }
+
+            inline void matchBits(const uint8_t *src, size_t n, uint8_t value, uint64_t *bits)
+            {
+                for (size_t word = 0; word < n / 64; ++word) {
+                    uint64_t mask = 0;
+                    for (size_t i = 0; i < 64; ++i)
+                        mask |= static_cast<uint64_t>(src[word * 64 + i] == value) << i;
+                    bits[word] = mask;
+                }
+            }
+
+            inline void diff(const uint8_t *a, const uint8_t *b, size_t n, uint32_t base, std::vector<uint32_t>& dirty)
+            {
+                for (size_t i = 0; i < n; ++i) {
+                    if (a[i] != b[i])
+                        dirty.push_back(base + static_cast<uint32_t>(i));
+                }
+            }
+
+            inline uint64_t checksum(const uint8_t *src, size_t n, uint64_t seed)
+            {
+                uint32_t lanes[detail::LANES];
+                detail::seedLanes(lanes, seed);
+                size_t i = 0;
+                for (; i + detail::STRIPE <= n; i += detail::STRIPE) {
+                    for (size_t j = 0; j < detail::LANES; ++j) {
+                        uint32_t word;
+                        std::memcpy(&word, src + i + j * 4, sizeof(word));
+                        lanes[j] = detail::round(lanes[j], word);
+                    }
+                }
+                return detail::finish(lanes, src + i, n - i, n, seed);
+            }
+
+            inline constexpr Table table {"scalar", fill, countByType, matchBits, diff, checksum};
+        }
+
+#ifdef ARCADE_KERNELS_X86
+        namespace sse2
+        {
+            __attribute__((target("sse2")))
+            inline void fill(uint8_t *dst, size_t n, uint8_t value)
+            {
+                const __m128i v = _mm_set1_epi8(static_cast<char>(value));
+                size_t i = 0;
+                for (; i + 16 <= n; i += 16)
+                    _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + i), v);
+                scalar::fill(dst + i, n - i, value);
+            }
+
+            __attribute__((target("sse2")))
+            inline void countByType(const uint8_t *src, size_t n, uint32_t *counts)
+            {
+                size_t i = 0;
+                // Compteurs sur 8 bits : au plus 255 tours avant de les vider
+                while (i + 16 <= n) {
+                    const size_t blocks = std::min<size_t>((n - i) / 16, 255);
+                    for (size_t type = 0; type < TYPE_COUNT; ++type) {
+                        const __m128i v = _mm_set1_epi8(static_cast<char>(type));
+                        __m128i acc = _mm_setzero_si128();
+                        for (size_t b = 0; b < blocks; ++b) {
+                            const __m128i cells = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + i + b * 16));
+                            acc = _mm_sub_epi8(acc, _mm_cmpeq_epi8(cells, v));
+                        }
+                        const __m128i sums = _mm_sad_epu8(acc, _mm_setzero_si128());
+                        counts[type] += static_cast<uint32_t>(_mm_cvtsi128_si32(sums) + _mm_extract_epi16(sums, 4));
+                    }
+                    i += blocks * 16;
+                }
+                scalar::countByType(src + i, n - i, counts);
+            }
+
+            __attribute__((target("sse2")))
+            inline void matchBits(const uint8_t *src, size_t n, uint8_t value, uint64_t *bits)
+            {
+                const __m128i v = _mm_set1_epi8(static_cast<char>(value));
+                for (size_t word = 0; word < n / 64; ++word) {
+                    uint64_t mask = 0;
+                    for (size_t part = 0; part < 4; ++part) {
+                        const __m128i cells = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + word * 64 + part * 16));
+                        const auto hits = static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(cells, v)));
+                        mask |= static_cast<uint64_t>(hits) << (part * 16);
+                    }
+                    bits[word] = mask;
+                }
+            }
+
+            __attribute__((target("sse2")))
+            inline void diff(const uint8_t *a, const uint8_t *b, size_t n, uint32_t base, std::vector<uint32_t>& dirty)
+            {
+                size_t i = 0;
+                for (; i + 16 <= n; i += 16) {
+                    const __m128i left = _mm_loadu_si128(reinterpret_cast<const __m128i *>(a + i));
+                    const __m128i right = _mm_loadu_si128(reinterpret_cast<const __m128i *>(b + i));
+                    const auto same = static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(left, right)));
+                    detail::pushMask(~same & 0xFFFFu, base + static_cast<uint32_t>(i), dirty);
+                }
+                scalar::diff(a + i, b + i, n - i, base + static_cast<uint32_t>(i), dirty);
+            }
+
+            // mullo 32 bits, absent de SSE2 : deux produits 32x32->64 recombinés
+            __attribute__((target("sse2")))
+            inline __m128i mullo32(__m128i a, __m128i b)
+            {
+                const __m128i even = _mm_mul_epu32(a, b);
+                const __m128i odd = _mm_mul_epu32(_mm_srli_epi64(a, 32), _mm_srli_epi64(b, 32));
+                return _mm_unpacklo_epi32(_mm_shuffle_epi32(even, _MM_SHUFFLE(0, 0, 2, 0)),
+                    _mm_shuffle_epi32(odd, _MM_SHUFFLE(0, 0, 2, 0)));
+            }
+
+            __attribute__((target("sse2")))
+            inline __m128i round(__m128i acc, __m128i words)
+            {
+                const __m128i prime1 = _mm_set1_epi32(static_cast<int>(detail::PRIME1));
+                const __m128i prime2 = _mm_set1_epi32(static_cast<int>(detail::PRIME2));
+                acc = _mm_add_epi32(acc, mullo32(words, prime2));
+                acc = _mm_or_si128(_mm_slli_epi32(acc, 13), _mm_srli_epi32(acc, 19));
+                return mullo32(acc, prime1);
+            }
+
+            __attribute__((target("sse2")))
+            inline uint64_t checksum(const uint8_t *src, size_t n, uint64_t seed)
+            {
+                alignas(16) uint32_t lanes[detail::LANES];
+                detail::seedLanes(lanes, seed);
+                __m128i low = _mm_load_si128(reinterpret_cast<const __m128i *>(lanes));
+                __m128i high = _mm_load_si128(reinterpret_cast<const __m128i *>(lanes + 4));
+                size_t i = 0;
+                for (; i + detail::STRIPE <= n; i += detail::STRIPE) {
+                    low = round(low, _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + i)));
+                    high = round(high, _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + i + 16)));
+                }
+                _mm_store_si128(reinterpret_cast<__m128i *>(lanes), low);
+                _mm_store_si128(reinterpret_cast<__m128i *>(lanes + 4), high);
+                return detail::finish(lanes, src + i, n - i, n, seed);
+            }
+
+            inline constexpr Table table {"sse2", fill, countByType, matchBits, diff, checksum};
+        }
+
+        namespace avx2
+        {
+            __attribute__((target("avx2")))
+            inline void fill(uint8_t *dst, size_t n, uint8_t value)
+            {
+                const __m256i v = _mm256_set1_epi8(static_cast<char>(value));
+                size_t i = 0;
+                for (; i + 32 <= n; i += 32)
+                    _mm256_storeu_si256(reinterpret_cast<__m256i *>(dst + i), v);
+                scalar::fill(dst + i, n - i, value);
+            }
+
+            __attribute__((target("avx2")))
+            inline void countByType(const uint8_t *src, size_t n, uint32_t *counts)
+            {
+                size_t i = 0;
+                while (i + 32 <= n) {
+                    const size_t blocks = std::min<size_t>((n - i) / 32, 255);
+                    for (size_t type = 0; type < TYPE_COUNT; ++type) {
+                        const __m256i v = _mm256_set1_epi8(static_cast<char>(type));
+                        __m256i acc = _mm256_setzero_si256();
+                        for (size_t b = 0; b < blocks; ++b) {
+                            const __m256i cells = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(src + i + b * 32));
+                            acc = _mm256_sub_epi8(acc, _mm256_cmpeq_epi8(cells, v));
+                        }
+                        const __m256i sums = _mm256_sad_epu8(acc, _mm256_setzero_si256());
+                        counts[type] += static_cast<uint32_t>(_mm256_extract_epi64(sums, 0) + _mm256_extract_epi64(sums, 1)
+                            + _mm256_extract_epi64(sums, 2) + _mm256_extract_epi64(sums, 3));
+                    }
+                    i += blocks * 32;
+                }
+                scalar::countByType(src + i, n - i, counts);
+            }
+
+            __attribute__((target("avx2")))
+            inline void matchBits(const uint8_t *src, size_t n, uint8_t value, uint64_t *bits)
+            {
+                const __m256i v = _mm256_set1_epi8(static_cast<char>(value));
+                for (size_t word = 0; word < n / 64; ++word) {
+                    const __m256i low = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(src + word * 64));
+                    const __m256i high = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(src + word * 64 + 32));
+                    const auto lowHits = static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(low, v)));
+                    const auto highHits = static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(high, v)));
+                    bits[word] = lowHits | (static_cast<uint64_t>(highHits) << 32);
+                }
+            }
+
+            __attribute__((target("avx2")))
+            inline void diff(const uint8_t *a, const uint8_t *b, size_t n, uint32_t base, std::vector<uint32_t>& dirty)
+            {
+                size_t i = 0;
+                for (; i + 32 <= n; i += 32) {
+                    const __m256i left = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(a + i));
+                    const __m256i right = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(b + i));
+                    const auto same = static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(left, right)));
+                    detail::pushMask(~same, base + static_cast<uint32_t>(i), dirty);
+                }
+                sse2::diff(a + i, b + i, n - i, base + static_cast<uint32_t>(i), dirty);
+            }
+
+            __attribute__((target("avx2")))
+            inline uint64_t checksum(const uint8_t *src, size_t n, uint64_t seed)
+            {
+                alignas(32) uint32_t lanes[detail::LANES];
+                detail::seedLanes(lanes, seed);
+                const __m256i prime1 = _mm256_set1_epi32(static_cast<int>(detail::PRIME1));
+                const __m256i prime2 = _mm256_set1_epi32(static_cast<int>(detail::PRIME2));
+                __m256i acc = _mm256_load_si256(reinterpret_cast<const __m256i *>(lanes));
+                size_t i = 0;
+                for (; i + detail::STRIPE <= n; i += detail::STRIPE) {
+                    const __m256i words = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(src + i));
+                    acc = _mm256_add_epi32(acc, _mm256_mullo_epi32(words, prime2));
+                    acc = _mm256_or_si256(_mm256_slli_epi32(acc, 13), _mm256_srli_epi32(acc, 19));
+                    acc = _mm256_mullo_epi32(acc, prime1);
+                }
+                _mm256_store_si256(reinterpret_cast<__m256i *>(lanes), acc);
+                return detail::finish(lanes, src + i, n - i, n, seed);
+            }
+
+            inline constexpr Table table {"avx2", fill, countByType, matchBits, diff, checksum};
+        }
+#endif
+
+        // Meilleure version disponible, ou celle demandée par ARCADE_SIMD
+        inline const Table& select(std::string_view wanted)
+        {
+#ifdef ARCADE_KERNELS_X86
+            __builtin_cpu_init();
+            const bool hasAvx2 = __builtin_cpu_supports("avx2");
+            if (wanted == "scalar")
+                return scalar::table;
+            if (wanted == "sse2" || !hasAvx2)
+                return sse2::table;
+            return avx2::table;
+#else
+            (void)wanted;
+            return scalar::table;
+#endif
+        }
+
+        inline const Table& active()
+        {
+            static const Table& table = [] () -> const Table& {
+                const char *wanted = std::getenv("ARCADE_SIMD");
+                return select(wanted ? wanted : "");
+            }();
+            return table;
+        }
+    }
+}
+
+#endif //GRIDKERNELS_HPP
@@ -0,0 +1,285 @@
+/*
+**  _                                              _      ___    ___
+** | |                                            | |    |__ \  / _ \
+** | |_Created _       _ __   _ __    ___    __ _ | |__     ) || (_) |
+** | '_ \ | | | |     | '_ \ | '_ \  / _ \  / _` || '_ \   / /  \__, |
+** | |_) || |_| |     | | | || | | || (_) || (_| || | | | / /_    / /
+** |_.__/  \__, |     |_| |_||_| |_| \___/  \__,_||_| |_||____|  /_/
+**          __/ |     on 18/10/26.
+**         |___/
+*/
+
+#ifndef LEVELFILE_HPP
+#define LEVELFILE_HPP
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "gameMap.hpp"
+
+/*
+ * Niveaux compilés (.lvl), produits depuis les cartes texte par arcade_mapc :
+ *
+ *     LevelHeader                       20 octets
+ *     palette[paletteSize]              EntityType utilisés, 1 octet chacun
+ *     LevelSpawn[spawnCount]            joueurs et ennemis, ordre de lecture
+ *     cases                             indices de palette sur bitsPerCell bits,
+ *                                       ligne par ligne, bit de poids faible d'abord
+ *
+ * Les entiers sont dans l'ordre de la machine qui a compilé le niveau : les
+ * .lvl sont générés par make, pas distribués.
+ */
+namespace Arcade
+{
+    struct LevelHeader {
+        char magic[4];
+        uint16_t version;
+        uint8_t bitsPerCell;
+        uint8_t paletteSize;
+        uint32_t width;
+        uint32_t height;
+        uint32_t spawnCount;
+    };
+    static_assert(sizeof(LevelHeader) == 20, "LevelHeader fait partie du format");
+
+    struct LevelSpawn {
+        uint16_t x;
+        uint16_t y;
+        EntityType entity;
+        uint8_t reserved;
+    };
+    static_assert(sizeof(LevelSpawn) == 6, "LevelSpawn fait partie du format");
+
+    inline constexpr char LEVEL_MAGIC[4] = {'A', 'L', 'V', 'L'};
+    inline constexpr uint16_t LEVEL_VERSION = 1;
+
+    inline bool isSpawn(EntityType type)
+    {
+        return type == EntityType::PLAYER || type == EntityType::ENEMY;
+    }
+
+    inline std::vector<LevelSpawn> findSpawns(const GameMap& map)
+    {
+        std::vector<LevelSpawn> spawns;
+        for (size_t y = 0; y < map.getHeight(); ++y) {
+            for (size_t x = 0; x < map.getWidth(); ++x) {
+                const EntityType type = map.getEntity(x, y);
+                if (isSpawn(type))
+                    spawns.push_back({static_cast<uint16_t>(x), static_cast<uint16_t>(y), type, 0});
+            }
+        }
+        return spawns;
+    }
+
+    // Image binaire d'une carte déjà chargée
+    inline std::vector<uint8_t> compileLevel(const GameMap& map)
+    {
+        if (map.getWidth() > UINT16_MAX || map.getHeight() > UINT16_MAX)
+            throw std::runtime_error("Level too large to compile");
+        const size_t cellCount = map.getWidth() * map.getHeight();
+
+        std::vector<EntityType> palette;
+        for (size_t type = 0; type < ENTITY_TYPE_COUNT; ++type) {
+            if (map.count(static_cast<EntityType>(type)) > 0)
+                palette.push_back(static_cast<EntityType>(type));
+        }
+        uint8_t bits = 1;
+        while ((size_t {1} << bits) < palette.size())
+            bits *= 2;
+        uint8_t indexOf[ENTITY_TYPE_COUNT] = {};
+        for (size_t i = 0; i < palette.size(); ++i)
+            indexOf[static_cast<size_t>(palette[i])] = static_cast<uint8_t>(i);
+
+        const std::vector<LevelSpawn> spawns = findSpawns(map);
+        LevelHeader header {};
+        std::memcpy(header.magic, LEVEL_MAGIC, sizeof(header.magic));
+        header.version = LEVEL_VERSION;
+        header.bitsPerCell = bits;
+        header.paletteSize = static_cast<uint8_t>(palette.size());
+        header.width = static_cast<uint32_t>(map.getWidth());
+        header.height = static_cast<uint32_t>(map.getHeight());
+        header.spawnCount = static_cast<uint32_t>(spawns.size());
+
+        std::vector<uint8_t> image(sizeof(header));
+        std::memcpy(image.data(), &header, sizeof(header));
+        for (const EntityType type : palette)
+            image.push_back(static_cast<uint8_t>(type));
+        const size_t spawnOffset = image.size();
+        image.resize(spawnOffset + spawns.size() * sizeof(LevelSpawn));
+        std::memcpy(image.data() + spawnOffset, spawns.data(), spawns.size() * sizeof(LevelSpawn));
+
+        const size_t cellOffset = image.size();
+        image.resize(cellOffset + (cellCount * bits + 7) / 8, 0);
+        for (size_t i = 0; i < cellCount; ++i) {
+            const size_t bit = i * bits;
+            const EntityType type = map.getEntity(i % map.getWidth(), i / map.getWidth());
+            image[cellOffset + bit / 8] |= static_cast<uint8_t>(indexOf[static_cast<size_t>(type)] << (bit % 8));
+        }
+        return image;
+    }
+
+    /*
+     * Niveau compilé projeté en mémoire. Le constructeur ne fait que valider
+     * l'en-tête ; loadInto() décode les cases directement dans la grille.
+     */
+    class MappedLevel {
+    private:
+        const uint8_t *_data = nullptr;
+        size_t _size = 0;
+        LevelHeader _header {};
+        const uint8_t *_palette = nullptr;
+        const uint8_t *_spawns = nullptr;
+        const uint8_t *_cells = nullptr;
+
+        void fail(const std::string& path, const char *reason)
+        {
+            munmap(const_cast<uint8_t *>(_data), _size);
+            throw std::runtime_error("Invalid level file " + path + ": " + reason);
+        }
+
+    public:
+        explicit MappedLevel(const std::string& path)
+        {
+            const int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+            if (fd < 0)
+                throw std::runtime_error("Could not open level file: " + path);
+            struct stat st {};
+            if (fstat(fd, &st) != 0 || st.st_size < static_cast<off_t>(sizeof(LevelHeader))) {
+                close(fd);
+                throw std::runtime_error("Invalid level file " + path + ": truncated header");
+            }
+            _size = static_cast<size_t>(st.st_size);
+            void *data = mmap(nullptr, _size, PROT_READ, MAP_PRIVATE, fd, 0);
+            close(fd);
+            if (data == MAP_FAILED)
+                throw std::runtime_error("Could not map level file: " + path);
+            _data = static_cast<const uint8_t *>(data);
+
+            std::memcpy(&_header, _data, sizeof(_header));
+            if (std::memcmp(_header.magic, LEVEL_MAGIC, sizeof(LEVEL_MAGIC)) != 0)
+                fail(path, "bad magic");
+            if (_header.version != LEVEL_VERSION)
+                fail(path, "unsupported version");
+            if (_header.bitsPerCell != 1 && _header.bitsPerCell != 2 && _header.bitsPerCell != 4 && _header.bitsPerCell != 8)
+                fail(path, "bad cell width");
+            if (_header.paletteSize == 0 || _header.paletteSize > (1u << _header.bitsPerCell))
+                fail(path, "bad palette");
+
+            const uint64_t cellCount = uint64_t {_header.width} * _header.height;
+            const uint64_t expected = sizeof(LevelHeader) + _header.paletteSize
+                + uint64_t {_header.spawnCount} * sizeof(LevelSpawn) + (cellCount * _header.bitsPerCell + 7) / 8;
+            if (expected != _size)
+                fail(path, "size mismatch");
+            _palette = _data + sizeof(LevelHeader);
+            _spawns = _palette + _header.paletteSize;
+            _cells = _spawns + _header.spawnCount * sizeof(LevelSpawn);
+            for (size_t i = 0; i < _header.paletteSize; ++i) {
+                if (_palette[i] >= ENTITY_TYPE_COUNT)
+                    fail(path, "unknown entity in palette");
+            }
+        }
+
+        ~MappedLevel()
+        {
+            munmap(const_cast<uint8_t *>(_data), _size);
+        }
+
+        MappedLevel(const MappedLevel&) = delete;
+        MappedLevel& operator=(const MappedLevel&) = delete;
+
+        size_t width() const { return _header.width; }
+        size_t height() const { return _header.height; }
+
+        std::vector<LevelSpawn> spawns() const
+        {
+            std::vector<LevelSpawn> result(_header.spawnCount);
+            std::memcpy(result.data(), _spawns, result.size() * sizeof(LevelSpawn));
+            return result;
+        }
+
+        void loadInto(GameMap& map) const
+        {
+            map.reshape(width(), height());
+            const unsigned bits = _header.bitsPerCell;
+            const unsigned mask = (1u << bits) - 1;
+            for (size_t y = 0; y < height(); ++y) {
+                for (size_t x = 0; x < width(); ++x) {
+                    const size_t bit = (y * width() + x) * bits;
+                    const unsigned slot = (_cells[bit / 8] >> (bit % 8)) & mask;
+                    map.setCell(x, y, static_cast<EntityType>(_palette[std::min<size_t>(slot, _header.paletteSize - 1u)]));
+                }
+            }
+        }
+    };
+
+    /*
+     * Charge textPath dans map. Si le .lvl compilé à côté existe et n'est pas
+     * plus ancien que le texte, il est projeté au lieu d'analyser le texte.
+     */
+    inline std::vector<LevelSpawn> loadLevel(GameMap& map, const std::string& textPath)
+    {
+        std::filesystem::path compiled(textPath);
+        compiled.replace_extension(".lvl");
+        std::error_code error;
+        const auto compiledTime = std::filesystem::last_write_time(compiled, error);
+        if (!error) {
+            const auto textTime = std::filesystem::last_write_time(textPath, error);
+            if (error || compiledTime >= textTime) {
+                const MappedLevel level(compiled.string());
+                level.loadInto(map);
+                return level.spawns();
+            }
+        }
+        map.chargeMap(textPath);
+        return findSpawns(map);
+    }
+
+    // État d'origine d'un niveau : décor et objets (sans acteurs), et points
+    // d'apparition où le jeu pose ses acteurs
+    struct Level {
+        GameMap grid {1, 0, 0};
+        std::vector<LevelSpawn> spawns;
+    };
+
+    /*
+     * Chaque niveau n'est chargé qu'une fois par module : les parties
+     * suivantes et les redémarrages repartent de cette copie. Le cache vit
+     * tant que la bibliothèque du jeu reste chargée.
+     */
+    inline std::shared_ptr<const Level> cachedLevel(const std::string& textPath)
+    {
+        static std::mutex lock;
+        static std::unordered_map<std::string, std::shared_ptr<const Level>> levels;
+
+        std::lock_guard guard(lock);
+        std::shared_ptr<const Level>& slot = levels[textPath];
+        if (!slot) {
+            auto level = std::make_shared<Level>();
+            level->spawns = loadLevel(level->grid, textPath);
+            level->grid.splitLayers();
+            slot = std::move(level);
+        }
+        return slot;
+    }
+
+    inline void applyLevel(GameMap& map, const Level& level)
+    {
+        map.restore(level.grid);
+    }
+}
+
+#endif //LEVELFILE_HPP
@@ -0,0 +1,420 @@
+/*
+**  _                                              _      ___    ___
+** | |                                            | |    |__ \  / _ \
+** | |_Created _       _ __   _ __    ___    __ _ | |__     ) || (_) |
+** | '_ \ | | | |     | '_ \ | '_ \  / _ \  / _` || '_ \   / /  \__, |
+** | |_) || |_| |     | | | || | | || (_) || (_| || | | | / /_    / /
+** |_.__/  \__, |     |_| |_||_| |_| \___/  \__,_||_| |_||____|  /_/
+**          __/ |     on 18/10/26.
+**         |___/
+*/
+
+#ifndef MAPSTREAM_HPP
+#define MAPSTREAM_HPP
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <istream>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "gameMap.hpp"
+
+/*
+ * Flux d'images de GameMap (enregistrements, spectateurs, références de
+ * non-régression). Les entiers sont des varint (7 bits par octet, poids
+ * faible d'abord) ; les entiers signés passent en zigzag.
+ *
+ *     "AMST" version:u16 keyframeInterval:u16
+ *     puis une image par enregistrement :
+ *
+ *     KEYFRAME  0x01  largeur hauteur HUD(tous les champs)
+ *                     (longueur valeur:u8)*          cases en RLE, ligne par ligne
+ *     DELTA     0x02  HUD(champs changés)
+ *                     segments (saut longueur xor:u8[longueur])*
+ *
+ * HUD : masque des champs présents, puis dans l'ordre score, highScore,
+ * vies, temps restant, niveau, gameOver, drapeaux (bits de MapFlag),
+ * message (longueur + octets). Dans un delta, le saut compte les cases
+ * inchangées depuis la fin du segment précédent, et chaque octet du
+ * segment est le xor entre l'ancienne et la nouvelle case.
+ *
+ * Une image clé est émise au début, tous les keyframeInterval images, au
+ * changement de dimensions, et quand plus d'une case sur deux change.
+ */
+namespace Arcade
+{
+    inline constexpr char MAP_STREAM_MAGIC[4] = {'A', 'M', 'S', 'T'};
+    inline constexpr uint16_t MAP_STREAM_VERSION = 1;
+
+    enum class MapRecord : uint8_t {
+        KEYFRAME = 1,
+        DELTA = 2
+    };
+
+    // Champs d'en-tête d'image, comparés d'une image à l'autre
+    struct MapHud {
+        enum Field : uint8_t {
+            SCORE = 1 << 0,
+            HIGH_SCORE = 1 << 1,
+            LIVES = 1 << 2,
+            TIME_LEFT = 1 << 3,
+            LEVEL = 1 << 4,
+            GAME_OVER = 1 << 5,
+            FLAGS = 1 << 6,
+            MESSAGE = 1 << 7,
+            ALL = 0xFF
+        };
+
+        int64_t score = 0;
+        int64_t highScore = 0;
+        int64_t lives = 0;
+        int64_t timeLeft = 0;
+        uint64_t level = 0;
+        bool gameOver = false;
+        uint64_t flags = 0;
+        std::string message;
+
+        static MapHud of(const GameMap& map)
+        {
+            MapHud hud;
+            hud.score = static_cast<int>(map.getScore());
+            hud.highScore = map.getHighScore();
+            hud.lives = static_cast<int>(map.getLives());
+            hud.timeLeft = map.getTimeLeft();
+            hud.level = map.getLevel();
+            hud.gameOver = map.isGameOver();
+            for (size_t flag = 0; flag < static_cast<size_t>(MapFlag::COUNT); ++flag) {
+                if (map.hasFlag(static_cast<MapFlag>(flag)))
+                    hud.flags |= uint64_t {1} << flag;
+            }
+            hud.message = map.getMessage();
+            return hud;
+        }
+
+        uint8_t changedFrom(const MapHud& other) const
+        {
+            uint8_t mask = 0;
+            mask |= score != other.score ? SCORE : 0;
+            mask |= highScore != other.highScore ? HIGH_SCORE : 0;
+            mask |= lives != other.lives ? LIVES : 0;
+            mask |= timeLeft != other.timeLeft ? TIME_LEFT : 0;
+            mask |= level != other.level ? LEVEL : 0;
+            mask |= gameOver != other.gameOver ? GAME_OVER : 0;
+            mask |= flags != other.flags ? FLAGS : 0;
+            mask |= message != other.message ? MESSAGE : 0;
+            return mask;
+        }
+
+        void applyTo(GameMap& map) const
+        {
+            map.setScore(static_cast<int>(score));
+            map.setHighScore(static_cast<int>(highScore));
+            map.setLives(static_cast<int>(lives));
+            map.setTimeLeft(static_cast<int>(timeLeft));
+            map.setLevel(static_cast<size_t>(level));
+            map.setGameOver(gameOver);
+            for (size_t flag = 0; flag < static_cast<size_t>(MapFlag::COUNT); ++flag)
+                map.setFlag(static_cast<MapFlag>(flag), (flags >> flag) & 1);
+            map.setMessage(message);
+        }
+    };
+
+    namespace stream
+    {
+        inline void putVarint(std::vector<uint8_t>& out, uint64_t value)
+        {
+            while (value >= 0x80) {
+                out.push_back(static_cast<uint8_t>(value | 0x80));
+                value >>= 7;
+            }
+            out.push_back(static_cast<uint8_t>(value));
+        }
+
+        inline void putSigned(std::vector<uint8_t>& out, int64_t value)
+        {
+            putVarint(out, (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63));
+        }
+
+        inline uint8_t getByte(std::istream& in)
+        {
+            const int byte = in.get();
+            if (byte == std::char_traits<char>::eof())
+                throw std::runtime_error("Invalid map stream: truncated record");
+            return static_cast<uint8_t>(byte);
+        }
+
+        inline uint64_t getVarint(std::istream& in)
+        {
+            uint64_t value = 0;
+            for (unsigned shift = 0; shift < 64; shift += 7) {
+                const uint8_t byte = getByte(in);
+                value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+                if (!(byte & 0x80))
+                    return value;
+            }
+            throw std::runtime_error("Invalid map stream: varint too long");
+        }
+
+        inline int64_t getSigned(std::istream& in)
+        {
+            const uint64_t value = getVarint(in);
+            return static_cast<int64_t>((value >> 1) ^ (~(value & 1) + 1));
+        }
+
+        inline void putHud(std::vector<uint8_t>& out, const MapHud& hud, uint8_t mask)
+        {
+            out.push_back(mask);
+            if (mask & MapHud::SCORE) putSigned(out, hud.score);
+            if (mask & MapHud::HIGH_SCORE) putSigned(out, hud.highScore);
+            if (mask & MapHud::LIVES) putSigned(out, hud.lives);
+            if (mask & MapHud::TIME_LEFT) putSigned(out, hud.timeLeft);
+            if (mask & MapHud::LEVEL) putVarint(out, hud.level);
+            if (mask & MapHud::GAME_OVER) out.push_back(hud.gameOver);
+            if (mask & MapHud::FLAGS) putVarint(out, hud.flags);
+            if (mask & MapHud::MESSAGE) {
+                putVarint(out, hud.message.size());
+                out.insert(out.end(), hud.message.begin(), hud.message.end());
+            }
+        }
+
+        inline void getHud(std::istream& in, MapHud& hud)
+        {
+            static constexpr size_t MAX_MESSAGE = 1 << 16;
+            const uint8_t mask = getByte(in);
+            if (mask & MapHud::SCORE) hud.score = getSigned(in);
+            if (mask & MapHud::HIGH_SCORE) hud.highScore = getSigned(in);
+            if (mask & MapHud::LIVES) hud.lives = getSigned(in);
+            if (mask & MapHud::TIME_LEFT) hud.timeLeft = getSigned(in);
+            if (mask & MapHud::LEVEL) hud.level = getVarint(in);
+            if (mask & MapHud::GAME_OVER) hud.gameOver = getByte(in) != 0;
+            if (mask & MapHud::FLAGS) hud.flags = getVarint(in);
+            if (mask & MapHud::MESSAGE) {
+                const uint64_t length = getVarint(in);
+                if (length > MAX_MESSAGE)
+                    throw std::runtime_error("Invalid map stream: message too long");
+                hud.message.resize(length);
+                if (!in.read(hud.message.data(), static_cast<std::streamsize>(length)))
+                    throw std::runtime_error("Invalid map stream: truncated message");
+            }
+        }
+    }
+
+    /*
+     * Encodeur : write() ajoute une image au flux. L'image précédente est
+     * gardée en copie partagée (O(1)) et comparée tuile par tuile avec
+     * GameMap::diff(), qui ne lit pas les tuiles inchangées.
+     */
+    class MapStreamWriter {
+    private:
+        std::ostream& _out;
+        size_t _keyframeInterval;
+        GameMap _previous {0, 0, 0};
+        MapHud _hud;
+        size_t _frames = 0;
+        size_t _sinceKeyframe = 0;
+        size_t _bytes = 0;
+        std::vector<uint8_t> _record;
+
+        void keyframe(const GameMap& map, const MapHud& hud)
+        {
+            _record.push_back(static_cast<uint8_t>(MapRecord::KEYFRAME));
+            stream::putVarint(_record, map.getWidth());
+            stream::putVarint(_record, map.getHeight());
+            stream::putHud(_record, hud, MapHud::ALL);
+            size_t run = 0;
+            EntityType current = EntityType::EMPTY;
+            for (const auto row : map.getCell()) {
+                for (const Cell& cell : row) {
+                    if (run > 0 && cell.entity != current) {
+                        stream::putVarint(_record, run);
+                        _record.push_back(static_cast<uint8_t>(current));
+                        run = 0;
+                    }
+                    current = cell.entity;
+                    run++;
+                }
+            }
+            if (run > 0) {
+                stream::putVarint(_record, run);
+                _record.push_back(static_cast<uint8_t>(current));
+            }
+            _sinceKeyframe = 0;
+        }
+
+        void delta(const GameMap& map, const MapHud& hud, std::vector<uint32_t>& dirty)
+        {
+            // Deux cases inchangées coûtent moins qu'un nouveau segment
+            static constexpr uint32_t MAX_GAP = 2;
+
+            _record.push_back(static_cast<uint8_t>(MapRecord::DELTA));
+            stream::putHud(_record, hud, hud.changedFrom(_hud));
+            std::sort(dirty.begin(), dirty.end());
+            std::vector<std::pair<uint32_t, uint32_t>> segments;
+            for (const uint32_t cell : dirty) {
+                if (!segments.empty() && cell - segments.back().second <= MAX_GAP)
+                    segments.back().second = cell + 1;
+                else
+                    segments.push_back({cell, cell + 1});
+            }
+            stream::putVarint(_record, segments.size());
+            const size_t width = map.getWidth();
+            uint32_t position = 0;
+            for (const auto& [first, last] : segments) {
+                stream::putVarint(_record, first - position);
+                stream::putVarint(_record, last - first);
+                for (uint32_t cell = first; cell < last; ++cell) {
+                    const auto before = static_cast<uint8_t>(_previous.getEntity(cell % width, cell / width));
+                    const auto after = static_cast<uint8_t>(map.getEntity(cell % width, cell / width));
+                    _record.push_back(before ^ after);
+                }
+                position = last;
+            }
+        }
+
+    public:
+        explicit MapStreamWriter(std::ostream& out, size_t keyframeInterval = 300)
+            : _out(out), _keyframeInterval(std::clamp<size_t>(keyframeInterval, 1, UINT16_MAX))
+        {
+            _record.assign(MAP_STREAM_MAGIC, MAP_STREAM_MAGIC + sizeof(MAP_STREAM_MAGIC));
+            const auto interval = static_cast<uint16_t>(_keyframeInterval);
+            _record.push_back(static_cast<uint8_t>(MAP_STREAM_VERSION));
+            _record.push_back(static_cast<uint8_t>(MAP_STREAM_VERSION >> 8));
+            _record.push_back(static_cast<uint8_t>(interval));
+            _record.push_back(static_cast<uint8_t>(interval >> 8));
+            _out.write(reinterpret_cast<const char *>(_record.data()), static_cast<std::streamsize>(_record.size()));
+            _bytes = _record.size();
+        }
+
+        void write(const GameMap& map)
+        {
+            if (map.getWidth() * map.getHeight() > UINT32_MAX)
+                throw std::runtime_error("Map too large for a map stream");
+            const MapHud hud = MapHud::of(map);
+            _record.clear();
+            const bool resized = map.getWidth() != _previous.getWidth() || map.getHeight() != _previous.getHeight();
+            if (_frames == 0 || resized || _sinceKeyframe + 1 >= _keyframeInterval) {
+                keyframe(map, hud);
+            } else {
+                std::vector<uint32_t> dirty = map.diff(_previous);
+                if (dirty.size() > map.getWidth() * map.getHeight() / 2)
+                    keyframe(map, hud);
+                else
+                    delta(map, hud, dirty);
+                _sinceKeyframe++;
+            }
+            _out.write(reinterpret_cast<const char *>(_record.data()), static_cast<std::streamsize>(_record.size()));
+            if (!_out)
+                throw std::runtime_error("Could not write map stream");
+            _bytes += _record.size();
+            _previous = map;
+            _hud = hud;
+            _frames++;
+        }
+
+        size_t frames() const { return _frames; }
+        size_t bytes() const { return _bytes; }
+    };
+
+    /*
+     * Décodeur : next() lit une image et l'applique à frame(). Les deltas
+     * passent par setCell(), si bien qu'un rendu qui suit frame() avec
+     * changesSince() ne redessine que les cases changées.
+     */
+    class MapStreamReader {
+    private:
+        std::istream& _in;
+        GameMap _frame {0, 0, 0};
+        MapHud _hud;
+        size_t _keyframeInterval = 0;
+        size_t _frames = 0;
+        bool _keyframe = false;
+
+        void readKeyframe()
+        {
+            const uint64_t width = stream::getVarint(_in);
+            const uint64_t height = stream::getVarint(_in);
+            if (width > UINT32_MAX || height > UINT32_MAX || (width != 0 && height > UINT32_MAX / width))
+                throw std::runtime_error("Invalid map stream: bad dimensions");
+            stream::getHud(_in, _hud);
+            _frame.reshape(width, height);
+            const uint64_t area = width * height;
+            for (uint64_t cell = 0; cell < area;) {
+                const uint64_t run = stream::getVarint(_in);
+                const uint8_t value = stream::getByte(_in);
+                if (run == 0 || run > area - cell || value >= ENTITY_TYPE_COUNT)
+                    throw std::runtime_error("Invalid map stream: bad keyframe run");
+                if (value != static_cast<uint8_t>(EntityType::EMPTY)) {
+                    for (uint64_t i = cell; i < cell + run; ++i)
+                        _frame.setCell(i % width, i / width, static_cast<EntityType>(value));
+                }
+                cell += run;
+            }
+        }
+
+        void readDelta()
+        {
+            if (_frames == 0)
+                throw std::runtime_error("Invalid map stream: delta before the first keyframe");
+            stream::getHud(_in, _hud);
+            const size_t width = _frame.getWidth();
+            const uint64_t area = width * _frame.getHeight();
+            const uint64_t segments = stream::getVarint(_in);
+            uint64_t position = 0;
+            for (uint64_t segment = 0; segment < segments; ++segment) {
+                const uint64_t skip = stream::getVarint(_in);
+                const uint64_t length = stream::getVarint(_in);
+                if (skip > area - position || length > area - position - skip)
+                    throw std::runtime_error("Invalid map stream: delta outside the map");
+                position += skip;
+                for (uint64_t cell = position; cell < position + length; ++cell) {
+                    const auto before = static_cast<uint8_t>(_frame.getEntity(cell % width, cell / width));
+                    const uint8_t after = before ^ stream::getByte(_in);
+                    if (after >= ENTITY_TYPE_COUNT)
+                        throw std::runtime_error("Invalid map stream: unknown entity");
+                    _frame.setCell(cell % width, cell / width, static_cast<EntityType>(after));
+                }
+                position += length;
+            }
+        }
+
+    public:
+        explicit MapStreamReader(std::istream& in) : _in(in)
+        {
+            char header[8];
+            if (!_in.read(header, sizeof(header)) || std::memcmp(header, MAP_STREAM_MAGIC, sizeof(MAP_STREAM_MAGIC)) != 0)
+                throw std::runtime_error("Invalid map stream: bad magic");
+            const auto byte = [&header] (size_t i) { return static_cast<uint8_t>(header[i]); };
+            if ((byte(4) | byte(5) << 8) != MAP_STREAM_VERSION)
+                throw std::runtime_error("Invalid map stream: unsupported version");
+            _keyframeInterval = byte(6) | byte(7) << 8;
+        }
+
+        // false à la fin du flux ; lève une exception s'il est corrompu
+        bool next()
+        {
+            const int kind = _in.get();
+            if (kind == std::char_traits<char>::eof())
+                return false;
+            if (kind == static_cast<int>(MapRecord::KEYFRAME))
+                readKeyframe();
+            else if (kind == static_cast<int>(MapRecord::DELTA))
+                readDelta();
+            else
+                throw std::runtime_error("Invalid map stream: unknown record");
+            _keyframe = kind == static_cast<int>(MapRecord::KEYFRAME);
+            _hud.applyTo(_frame);
+            _frames++;
+            return true;
+        }
+
+        const GameMap& frame() const { return _frame; }
+        size_t frames() const { return _frames; }
+        bool isKeyframe() const { return _keyframe; }
+        size_t keyframeInterval() const { return _keyframeInterval; }
+    };
+}
+
+#endif //MAPSTREAM_HPP
@@ -12,21 +12,65 @@
 #ifndef MY_HPP
 #define MY_HPP
 
+#include <chrono>
 #include <memory>
 #include <fstream>
+#include <stdexcept>
+#include <string>
+#include <utility>
 
 namespace Arcade
 {
+    // Version des interfaces IGame / IGraphics. Chaque plugin l'exporte via
+    // getApiVersion() ; le core refuse un plugin compilé contre une autre.
+    inline constexpr unsigned int API_VERSION = 2;
+
     enum class Input {
         UP, DOWN, LEFT, RIGHT, ENTER,
         BACK, SWITCH_GAME, SWITCH_LIB,
-        RESTART, EXIT, MENU, NONE, ESCAPE
+        RESTART, EXIT, MENU, NONE, ESCAPE,
+        PROFILER
+    };
+
+    // Entrée horodatée au moment où le backend l'a relevée
+    struct InputEvent {
+        Input input = Input::NONE;
+        std::chrono::steady_clock::time_point timestamp {};
     };
+
+    inline constexpr std::pair<const char *, Input> INPUT_NAMES[] = {
+        {"UP", Input::UP}, {"DOWN", Input::DOWN}, {"LEFT", Input::LEFT}, {"RIGHT", Input::RIGHT},
+        {"ENTER", Input::ENTER}, {"BACK", Input::BACK}, {"SWITCH_GAME", Input::SWITCH_GAME},
+        {"SWITCH_LIB", Input::SWITCH_LIB}, {"RESTART", Input::RESTART}, {"EXIT", Input::EXIT},
+        {"MENU", Input::MENU}, {"NONE", Input::NONE}, {"ESCAPE", Input::ESCAPE},
+        {"PROFILER", Input::PROFILER},
+    };
+
+    inline std::string inputToString(Input input)
+    {
+        for (const auto& [name, value] : INPUT_NAMES) {
+            if (value == input)
+                return name;
+        }
+        return "NONE";
+    }
+
+    inline Input inputFromString(const std::string& name)
+    {
+        for (const auto& [key, value] : INPUT_NAMES) {
+            if (name == key)
+                return value;
+        }
+        throw std::runtime_error("Unknown input: " + name);
+    }
 }
 
 std::string getNextGame();
 std::string getNextGraphics();
+std::string peekNextGame();
+std::string peekNextGraphics();
 
 int random(int a, int b);
+void seedRandom(unsigned int seed);
 
 #endif //MY_HPP
@@ -0,0 +1,82 @@
+/*
+**  _                                              _      ___    ___
+** | |                                            | |    |__ \  / _ \
+** | |_Created _       _ __   _ __    ___    __ _ | |__     ) || (_) |
+** | '_ \ | | | |     | '_ \ | '_ \  / _ \  / _` || '_ \   / /  \__, |
+** | |_) || |_| |     | | | || | | || (_) || (_| || | | | / /_    / /
+** |_.__/  \__, |     |_| |_||_| |_| \___/  \__,_||_| |_||____|  /_/
+**          __/ |     on 18/10/26.
+**         |___/
+*/
+
+#ifndef TRACE_HPP
+#define TRACE_HPP
+
+#include <atomic>
+#include <chrono>
+
+namespace Arcade
+{
+    // Destination des zones mesurées ; implémentée par le core (Tracer).
+    class ITraceSink {
+    public:
+        virtual ~ITraceSink() = default;
+        // name n'a besoin de vivre que le temps de l'appel : il est recopié
+        virtual void record(const char *name, std::chrono::steady_clock::time_point start,
+            std::chrono::steady_clock::time_point end) = 0;
+        virtual void nameThread(const char *name) = 0;
+    };
+
+    namespace trace
+    {
+        // Une copie par module : le core la renseigne pour lui-même, puis
+        // pour chaque plugin via son symbole setTraceSink.
+        inline std::atomic<ITraceSink *>& sink()
+        {
+            static std::atomic<ITraceSink *> current {nullptr};
+            return current;
+        }
+
+        inline void setSink(ITraceSink *value)
+        {
+            sink().store(value, std::memory_order_release);
+        }
+
+        inline void nameThread(const char *name)
+        {
+            if (ITraceSink *target = sink().load(std::memory_order_acquire))
+                target->nameThread(name);
+        }
+    }
+
+    /*
+     * Zone mesurée du constructeur au destructeur :
+     *     Arcade::TraceZone zone("Snake::moveSnake");
+     * Sans trace active, elle ne coûte qu'une lecture atomique.
+     */
+    class TraceZone {
+    private:
+        ITraceSink *_sink;
+        const char *_name;
+        std::chrono::steady_clock::time_point _start;
+
+    public:
+        explicit TraceZone(const char *name)
+            : _sink(trace::sink().load(std::memory_order_acquire)), _name(name)
+        {
+            if (_sink)
+                _start = std::chrono::steady_clock::now();
+        }
+
+        ~TraceZone()
+        {
+            if (_sink)
+                _sink->record(_name, _start, std::chrono::steady_clock::now());
+        }
+
+        TraceZone(const TraceZone&) = delete;
+        TraceZone& operator=(const TraceZone&) = delete;
+    };
+}
+
+#endif //TRACE_HPP
@@ -13,13 +13,23 @@
 #include <memory>
 #include <random>
 
-int random(int a, int b)
+static std::mt19937& generator()
 {
     static std::random_device rd;  // Générateur de nombres aléatoires basé sur le matériel
     static std::mt19937 gen(rd()); // Mersenne Twister PRNG
+    return gen;
+}
+
+int random(int a, int b)
+{
     std::uniform_int_distribution<int> distrib(a, b); // Distribution uniforme entre 1 et 4
 
-    return distrib(gen);
+    return distrib(generator());
+}
+
+void seedRandom(unsigned int seed)
+{
+    generator().seed(seed);
 }
 
 void bof (int *i)
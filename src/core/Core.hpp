@@ -11,10 +11,23 @@
 
 #ifndef CORE_HPP
 #define CORE_HPP
+#include <atomic>
+#include <cstdlib>
+#include <filesystem>
 #include <memory>
+#include <random>
+#include <thread>
+#include <vector>
 
 #include "../games/IGame.hpp"
 #include "../graphicals/IGraphics.hpp"
+#include "InputQueue.hpp"
+#include "Preloader.hpp"
+#include "Profiler.hpp"
+#include "Replay.hpp"
+#include "Scheduler.hpp"
+#include "Tracer.hpp"
+#include "TripleBuffer.hpp"
 #include <dlfcn.h>
 
 
@@ -24,53 +37,154 @@ private:
     std::unique_ptr<Arcade::IGraphics> _graphics;
     void* _gameHandle = nullptr;
     void* _graphicsHandle = nullptr;
+    Scheduler _scheduler;
+    InputQueue _inputs;
+    std::vector<Arcade::InputEvent> _polled;
+    std::unique_ptr<ReplayRecorder> _recorder;
+    std::unique_ptr<ReplayPlayer> _player;
+    size_t _tick = 0;
+    FrameProfiler _profiler;
+    std::string _gamePath;
+    std::unique_ptr<Tracer> _tracer = Tracer::fromEnv();
+    std::future<GamePlugin> _nextGame;
+    std::future<GraphicsLibrary> _nextGraphics;
+    BackgroundWorker _worker;
 
-    void loadGame(const std::string& libPath)
+    // ARCADE_REPLAY rejoue un enregistrement à pleine vitesse, ARCADE_RECORD
+    // enregistre la session en cours.
+    void setupReplay()
     {
-        _gameHandle = dlopen(libPath.c_str(), RTLD_LAZY);
-        if (!_gameHandle) throw std::runtime_error(dlerror());
+        SchedulerConfig config = SchedulerConfig::fromEnv();
+        if (const char *replay = std::getenv("ARCADE_REPLAY")) {
+            _player = std::make_unique<ReplayPlayer>(replay);
+            config.tickRate = _player->tickRate();
+            config.uncapped = true;
+            config.threaded = false;
+        } else if (const char *record = std::getenv("ARCADE_RECORD")) {
+            _recorder = std::make_unique<ReplayRecorder>(record, config.tickRate);
+        }
+        _scheduler = Scheduler(config);
+        if (const char *profile = std::getenv("ARCADE_PROFILE"))
+            _profiler.setEnabled(std::string(profile) != "0");
+    }
+
+    unsigned int nextSeed()
+    {
+        return _player ? _player->nextSeed() : std::random_device{}();
+    }
 
-        void *createGame = dlsym(_gameHandle, "createGame");
-        if (!createGame) {
-            dlclose(_gameHandle);
-            throw std::runtime_error("Could not find symbol 'createGame' in " + libPath);
+    // Installe un jeu prêt à jouer ; l'ancien est détruit en arrière-plan.
+    void installGame(GamePlugin plugin)
+    {
+        if (_game) {
+            Arcade::IGame *previous = _game.release();
+            void *handle = _gameHandle;
+            _worker.submit([previous, handle] {
+                delete previous;
+                if (handle) dlclose(handle);
+            });
         }
+        if (_recorder) _recorder->seed(_tick, plugin.seed);
+        _game = std::move(plugin.game);
+        _gameHandle = plugin.handle;
+        _gamePath = plugin.path;
+    }
 
-        const auto gameFactory = reinterpret_cast<Arcade::IGame*(*)()>(createGame);
-        if (gameFactory != nullptr)
-            _game.reset(gameFactory());
-        else
-            throw std::runtime_error("Failed to cast createGame symbol.");
+    // La fenêtre est détruite et recréée ici, sur le thread qui la possède ;
+    // seul le dlclose de l'ancienne bibliothèque part en arrière-plan.
+    void installGraphics(GraphicsLibrary library)
+    {
+        _graphics.reset();
+        if (void *handle = _graphicsHandle)
+            _worker.submit([handle] { dlclose(handle); });
+        _graphicsHandle = library.handle;
+        _graphics.reset(library.factory());
+    }
+
+    // Deux instances d'une même bibliothèque partageraient ses variables
+    // globales (le générateur de random() par exemple) : on ne précharge pas
+    // le jeu en cours. Un rejeu charge ses jeux au moment du changement pour
+    // consommer les graines dans l'ordre où elles ont été écrites.
+    void prepareNextGame()
+    {
+        const std::string path = peekNextGame();
+        std::error_code error;
+        if (_player || path.empty() || std::filesystem::equivalent(path, _gamePath, error))
+            return;
+        const unsigned int seed = nextSeed();
+        _nextGame = _worker.run<GamePlugin>([path, seed] { return openGame(path, seed); });
     }
 
-    void loadGraphics(const std::string& libPath)
+    void prepareNextGraphics()
     {
-        _graphicsHandle = dlopen(libPath.c_str(), RTLD_LAZY);
-        if (!_graphicsHandle) throw std::runtime_error(dlerror());
+        const std::string path = peekNextGraphics();
+        if (path.empty())
+            return;
+        _nextGraphics = _worker.run<GraphicsLibrary>([path] { return openGraphics(path); });
+    }
+
+    static void discard(GamePlugin& plugin)
+    {
+        plugin.game.reset();
+        if (plugin.handle) dlclose(plugin.handle);
+    }
 
-        void *createGraphics = dlsym(_graphicsHandle, "createGraphics");
-        if (!createGraphics) {
-            dlclose(_graphicsHandle);
-            throw std::runtime_error("Could not find symbol 'createGraphics' in " + libPath);
+    // Reprend le jeu préchargé s'il correspond, sinon charge de façon synchrone.
+    GamePlugin takeGame(const std::string& libPath)
+    {
+        if (_nextGame.valid()) {
+            try {
+                GamePlugin plugin = _nextGame.get();
+                if (plugin.path == libPath)
+                    return plugin;
+                discard(plugin);
+            } catch (const std::exception& e) {
+                std::cerr << e.what() << std::endl;
+            }
         }
+        return openGame(libPath, nextSeed());
+    }
 
-        const auto graphicsFactory = reinterpret_cast<Arcade::IGraphics*(*)()>(createGraphics);
-        if (graphicsFactory != nullptr)
-            _graphics.reset(graphicsFactory());
-        else
-            throw std::runtime_error("Failed to cast createGraphics symbol.");
+    GraphicsLibrary takeGraphics(const std::string& libPath)
+    {
+        if (_nextGraphics.valid()) {
+            try {
+                GraphicsLibrary library = _nextGraphics.get();
+                if (library.path == libPath)
+                    return library;
+                dlclose(library.handle);
+            } catch (const std::exception& e) {
+                std::cerr << e.what() << std::endl;
+            }
+        }
+        return openGraphics(libPath);
     }
+
 public:
     Core(const std::string& gamePath,  const std::string& graphPath){
-        //(void)gamePath;
-        loadGame(gamePath);
-        //(void)graphPath;
-        //std::cout << "game is loaded" << std::endl;
-        loadGraphics(graphPath);
-        //std::cout << "graphics is loaded" << std::endl;
+        Arcade::trace::nameThread("main");
+        setupReplay();
+        installGame(openGame(gamePath, nextSeed()));
+        installGraphics(openGraphics(graphPath));
+        prepareNextGame();
+        prepareNextGraphics();
     }
 
+    // Le worker, déclaré en dernier, est joint en premier : les démontages
+    // encore en file sont terminés avant de fermer les bibliothèques courantes.
     ~Core() {
+        if (_recorder) _recorder->end(_tick);
+        if (_nextGame.valid()) {
+            try {
+                GamePlugin plugin = _nextGame.get();
+                discard(plugin);
+            } catch (const std::exception&) {}
+        }
+        if (_nextGraphics.valid()) {
+            try {
+                dlclose(_nextGraphics.get().handle);
+            } catch (const std::exception&) {}
+        }
         _game.reset();
         _graphics.reset();
         if (_gameHandle)     dlclose(_gameHandle);
@@ -78,24 +192,17 @@ public:
     }
 
     void changeLib(const std::string& lib) {
+        Arcade::TraceZone trace("Core::changeLib");
         if (lib == "graphics") {
-            if (_graphicsHandle) {
-                _graphics.reset();
-                dlclose(_graphicsHandle);
-            }
-            _gameHandle = nullptr;
             const std::string nextGraphicsPath = getNextGraphics();
             std::cout << nextGraphicsPath << std::endl;
-            loadGraphics(nextGraphicsPath);
+            installGraphics(takeGraphics(nextGraphicsPath));
+            prepareNextGraphics();
         }
         if (lib == "games") {
-            if (_gameHandle) {
-                _game.reset();
-                dlclose(_gameHandle);
-            }
-            _gameHandle = nullptr;
             const std::string nextGamesPath = getNextGame();
-            loadGame(nextGamesPath);
+            installGame(takeGame(nextGamesPath));
+            prepareNextGame();
         }
     }
 
@@ -104,16 +211,136 @@ public:
         if (!_game)     throw std::runtime_error("Could not load Game");
         if (!_graphics) throw std::runtime_error("Could not load Graphics library");
 
-        _game->initMap();
-        while (true) {
-            auto user_input = Arcade::Input::NONE;
-            user_input = _graphics->getInput();
-            if (user_input == Arcade::Input::ESCAPE) break;
-            if (user_input == Arcade::Input::SWITCH_LIB) changeLib("graphics");
-            if (user_input == Arcade::Input::SWITCH_GAME) changeLib("game");
-            _game->update(user_input);
-            _graphics->draw(_game->getMap());
+        if (_scheduler.getConfig().threaded)
+            runThreaded();
+        else
+            runSerial();
+        if (_profiler.enabled())
+            for (const auto& line : _profiler.overlay())
+                std::cerr << "[profile] " << line << std::endl;
+    }
+
+private:
+    // Relève les entrées du backend et les range dans la file ; ESCAPE et
+    // SWITCH_LIB sont traités ici car ils concernent le thread de rendu.
+    bool collectInputs()
+    {
+        bool running = true;
+
+        _polled.clear();
+        {
+            Arcade::TraceZone trace("Core::pollInputs");
+            auto zone = _profiler.measure(Phase::INPUT);
+            _graphics->pollInputs(_polled);
+        }
+        for (const auto& event : _polled) {
+            if (event.input == Arcade::Input::ESCAPE) running = false;
+            else if (event.input == Arcade::Input::SWITCH_LIB) changeLib("graphics");
+            else if (event.input == Arcade::Input::PROFILER) toggleProfiler();
+            else if (!_player) _inputs.push(event);
+        }
+        return running && !(_player && _player->finished(_tick));
+    }
+
+    // Une entrée au plus par pas : les suivantes restent dans la file pour
+    // les pas d'après au lieu d'être écrasées.
+    void step(Arcade::Input input, Scheduler::clock::duration dt)
+    {
+        if (_recorder) _recorder->input(_tick, input);
+        if (input == Arcade::Input::SWITCH_GAME) changeLib("games");
+        _game->advanceClock(dt);
+        {
+            Arcade::TraceZone trace("IGame::update");
+            auto zone = _profiler.measure(Phase::UPDATE);
+            _game->update(input);
+        }
+        _tick++;
+    }
+
+    void toggleProfiler()
+    {
+        _profiler.toggle();
+        if (!_profiler.enabled())
+            _graphics->setOverlay({});
+    }
+
+    const Arcade::GameMap& currentMap()
+    {
+        Arcade::TraceZone trace("IGame::viewMap");
+        auto zone = _profiler.measure(Phase::GET_MAP);
+        return _game->viewMap();
+    }
+
+    // Seul le mode threadé copie la carte, pour la publier à l'autre thread ;
+    // l'affectation réutilise les tampons de l'image précédente.
+    void snapshotInto(Arcade::GameMap& target)
+    {
+        Arcade::TraceZone trace("IGame::viewMap");
+        auto zone = _profiler.measure(Phase::GET_MAP);
+        target = _game->viewMap();
+    }
+
+    void render(const Arcade::GameMap& map)
+    {
+        if (_profiler.enabled())
+            _graphics->setOverlay(_profiler.overlay());
+        Arcade::TraceZone trace("IGraphics::draw");
+        auto zone = _profiler.measure(Phase::DRAW);
+        _graphics->draw(map);
+    }
+
+    Arcade::Input nextInput()
+    {
+        if (_player) return _player->inputAt(_tick);
+        Arcade::InputEvent event;
+        return _inputs.pop(event) ? event.input : Arcade::Input::NONE;
+    }
+
+    void runSerial()
+    {
+        _scheduler.start();
+        while (collectInputs()) {
+            for (size_t ticks = _scheduler.pendingTicks(); ticks > 0; --ticks)
+                step(nextInput(), _scheduler.tickDuration());
+            if (_scheduler.renderDue())
+                render(currentMap());
+            _scheduler.sleepUntilNextEvent();
+        }
+    }
+
+    // La simulation tourne sur son propre thread et publie chaque état dans un
+    // triple buffer ; ce thread-ci (celui qui a créé la fenêtre) relève les
+    // entrées et dessine toujours la dernière image publiée.
+    void runThreaded()
+    {
+        TripleBuffer<Arcade::GameMap> frames(_game->viewMap());
+        std::atomic<bool> running {true};
+
+        std::thread simulation([&] {
+            Arcade::trace::nameThread("simulation");
+            Scheduler simClock(_scheduler.getConfig());
+            while (running.load(std::memory_order_relaxed)) {
+                const size_t ticks = simClock.pendingTicks();
+                for (size_t i = 0; i < ticks; ++i)
+                    step(nextInput(), simClock.tickDuration());
+                if (ticks > 0) {
+                    snapshotInto(frames.back());
+                    frames.publish();
+                }
+                simClock.sleepUntilNextTick();
+            }
+        });
+
+        _scheduler.start();
+        while (collectInputs()) {
+            if (_scheduler.renderDue()) {
+                frames.update();
+                render(frames.front());
+            }
+            _scheduler.sleepUntilNextRender();
         }
+        running.store(false, std::memory_order_relaxed);
+        simulation.join();
     }
 };
 
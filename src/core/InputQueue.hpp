@@ -0,0 +1,63 @@
+/*
+**  _                                              _      ___    ___
+** | |                                            | |    |__ \  / _ \
+** | |_Created _       _ __   _ __    ___    __ _ | |__     ) || (_) |
+** | '_ \ | | | |     | '_ \ | '_ \  / _ \  / _` || '_ \   / /  \__, |
+** | |_) || |_| |     | | | || | | || (_) || (_| || | | | / /_    / /
+** |_.__/  \__, |     |_| |_||_| |_| \___/  \__,_||_| |_||____|  /_/
+**          __/ |     on 18/10/26.
+**         |___/
+*/
+
+#ifndef INPUTQUEUE_HPP
+#define INPUTQUEUE_HPP
+#include <array>
+#include <atomic>
+#include <cstddef>
+
+#include "../../includes/my.hpp"
+
+/*
+ * File circulaire sans verrou à un producteur (le thread qui relève les
+ * entrées du backend) et un consommateur (le thread de simulation).
+ * Quand elle est pleine, push() refuse l'élément au lieu de bloquer.
+ */
+template <typename T, size_t Capacity>
+class SpscRing {
+    static_assert(Capacity > 0 && (Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two");
+
+private:
+    alignas(64) std::atomic<size_t> _head {0};
+    alignas(64) std::atomic<size_t> _tail {0};
+    std::array<T, Capacity> _slots {};
+
+public:
+    bool push(const T& value)
+    {
+        const size_t tail = _tail.load(std::memory_order_relaxed);
+        if (tail - _head.load(std::memory_order_acquire) == Capacity)
+            return false;
+        _slots[tail & (Capacity - 1)] = value;
+        _tail.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool pop(T& value)
+    {
+        const size_t head = _head.load(std::memory_order_relaxed);
+        if (head == _tail.load(std::memory_order_acquire))
+            return false;
+        value = _slots[head & (Capacity - 1)];
+        _head.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool empty() const
+    {
+        return _head.load(std::memory_order_acquire) == _tail.load(std::memory_order_acquire);
+    }
+};
+
+using InputQueue = SpscRing<Arcade::InputEvent, 256>;
+
+#endif //INPUTQUEUE_HPP
@@ -0,0 +1,223 @@
+/*
+**  _                                              _      ___    ___
+** | |                                            | |    |__ \  / _ \
+** | |_Created _       _ __   _ __    ___    __ _ | |__     ) || (_) |
+** | '_ \ | | | |     | '_ \ | '_ \  / _ \  / _` || '_ \   / /  \__, |
+** | |_) || |_| |     | | | || | | || (_) || (_| || | | | / /_    / /
+** |_.__/  \__, |     |_| |_||_| |_| \___/  \__,_||_| |_||____|  /_/
+**          __/ |     on 18/10/26.
+**         |___/
+*/
+
+#ifndef PLUGINSCANNER_HPP
+#define PLUGINSCANNER_HPP
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <dlfcn.h>
+#include <elf.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+enum class PluginKind {
+    NONE,
+    GAME,
+    GRAPHICS
+};
+
+struct PluginInfo {
+    std::string path;
+    PluginKind kind = PluginKind::NONE;
+};
+
+/*
+ * Découverte des plugins en une passe : chaque fichier du dossier est classé
+ * en lisant la table .dynsym de l'ELF (aucun dlopen, donc aucun constructeur
+ * exécuté). Le résultat est mis en cache par chemin + inode + mtime + taille,
+ * de sorte qu'un démarrage sans changement ne relit aucun fichier.
+ */
+class PluginScanner {
+private:
+    struct CacheEntry {
+        ino_t inode = 0;
+        long long mtime = 0;
+        off_t size = 0;
+        PluginKind kind = PluginKind::NONE;
+    };
+
+    static constexpr const char *CACHE_NAME = ".plugins_cache";
+    static constexpr const char *CACHE_MAGIC = "ARCADE-PLUGINS 1";
+
+    std::filesystem::path _directory;
+    std::unordered_map<std::string, CacheEntry> _cache;
+    bool _cacheDirty = false;
+
+    static long long mtimeOf(const struct stat& st)
+    {
+        return static_cast<long long>(st.st_mtim.tv_sec) * 1'000'000'000LL + st.st_mtim.tv_nsec;
+    }
+
+    static PluginKind kindOfSymbol(const char *name)
+    {
+        if (std::strcmp(name, "createGame") == 0) return PluginKind::GAME;
+        if (std::strcmp(name, "createGraphics") == 0) return PluginKind::GRAPHICS;
+        return PluginKind::NONE;
+    }
+
+    // Parcourt les symboles dynamiques définis de l'image ELF64 projetée en
+    // mémoire ; renvoie false si le fichier est un ELF que l'on ne sait pas lire.
+    static bool inspectElf(const unsigned char *data, size_t size, PluginKind& kind)
+    {
+        if (size < sizeof(Elf64_Ehdr) || std::memcmp(data, ELFMAG, SELFMAG) != 0)
+            return true;
+        if (data[EI_CLASS] != ELFCLASS64)
+            return false;
+
+        const auto *header = reinterpret_cast<const Elf64_Ehdr *>(data);
+        if (header->e_type != ET_DYN)
+            return true;
+        if (header->e_shoff == 0 || header->e_shentsize != sizeof(Elf64_Shdr))
+            return false;
+        if (header->e_shoff > size || header->e_shnum > (size - header->e_shoff) / sizeof(Elf64_Shdr))
+            return false;
+
+        const auto *sections = reinterpret_cast<const Elf64_Shdr *>(data + header->e_shoff);
+        for (size_t i = 0; i < header->e_shnum; ++i) {
+            const Elf64_Shdr& symtab = sections[i];
+            if (symtab.sh_type != SHT_DYNSYM || symtab.sh_link >= header->e_shnum)
+                continue;
+            const Elf64_Shdr& strtab = sections[symtab.sh_link];
+            if (symtab.sh_offset > size || symtab.sh_size > size - symtab.sh_offset
+                || strtab.sh_offset > size || strtab.sh_size > size - strtab.sh_offset)
+                return false;
+
+            const auto *symbols = reinterpret_cast<const Elf64_Sym *>(data + symtab.sh_offset);
+            const auto *names = reinterpret_cast<const char *>(data + strtab.sh_offset);
+            const size_t count = symtab.sh_size / sizeof(Elf64_Sym);
+            for (size_t s = 0; s < count; ++s) {
+                if (symbols[s].st_shndx == SHN_UNDEF || symbols[s].st_name >= strtab.sh_size)
+                    continue;
+                const char *name = names + symbols[s].st_name;
+                if (std::memchr(name, '\0', strtab.sh_size - symbols[s].st_name) == nullptr)
+                    continue;
+                kind = kindOfSymbol(name);
+                if (kind != PluginKind::NONE)
+                    return true;
+            }
+        }
+        return true;
+    }
+
+    // Dernier recours pour un ELF que l'on ne sait pas lire (32 bits, sans
+    // table de sections) : on le charge sans lever d'exception en cas d'échec.
+    static PluginKind probeWithDlopen(const std::string& path)
+    {
+        void *handle = dlopen(path.c_str(), RTLD_LAZY | RTLD_LOCAL);
+        if (!handle)
+            return PluginKind::NONE;
+        PluginKind kind = PluginKind::NONE;
+        if (dlsym(handle, "createGame")) kind = PluginKind::GAME;
+        else if (dlsym(handle, "createGraphics")) kind = PluginKind::GRAPHICS;
+        dlclose(handle);
+        return kind;
+    }
+
+    static PluginKind inspect(const std::string& path, const struct stat& st)
+    {
+        if (st.st_size < static_cast<off_t>(sizeof(Elf64_Ehdr)))
+            return PluginKind::NONE;
+        const int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd < 0)
+            return PluginKind::NONE;
+        void *data = mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+        close(fd);
+        if (data == MAP_FAILED)
+            return PluginKind::NONE;
+
+        PluginKind kind = PluginKind::NONE;
+        const bool understood = inspectElf(static_cast<const unsigned char *>(data), static_cast<size_t>(st.st_size), kind);
+        munmap(data, static_cast<size_t>(st.st_size));
+        return understood ? kind : probeWithDlopen(path);
+    }
+
+    void loadCache()
+    {
+        std::ifstream file(_directory / CACHE_NAME);
+        std::string line;
+        if (!std::getline(file, line) || line != CACHE_MAGIC)
+            return;
+        while (std::getline(file, line)) {
+            std::istringstream words(line);
+            CacheEntry entry;
+            int kind = 0;
+            std::string path;
+            if (!(words >> entry.inode >> entry.mtime >> entry.size >> kind) || !std::getline(words >> std::ws, path))
+                continue;
+            entry.kind = static_cast<PluginKind>(kind);
+            _cache[path] = entry;
+        }
+    }
+
+    // Best effort : un dossier en lecture seule fait juste perdre le cache.
+    void saveCache() const
+    {
+        std::ofstream file(_directory / CACHE_NAME, std::ios::trunc);
+        if (!file.is_open())
+            return;
+        file << CACHE_MAGIC << '\n';
+        for (const auto& [path, entry] : _cache)
+            file << entry.inode << ' ' << entry.mtime << ' ' << entry.size << ' '
+                 << static_cast<int>(entry.kind) << ' ' << path << '\n';
+    }
+
+public:
+    explicit PluginScanner(const std::string& directory) : _directory(directory) {}
+
+    std::vector<PluginInfo> scan()
+    {
+        std::vector<PluginInfo> plugins;
+        std::error_code error;
+        if (!std::filesystem::is_directory(_directory, error))
+            return plugins;
+
+        loadCache();
+        std::unordered_map<std::string, CacheEntry> seen;
+        for (const auto& entry : std::filesystem::directory_iterator(_directory, error)) {
+            const std::string path = entry.path().string();
+            struct stat st {};
+            if (entry.path().filename() == CACHE_NAME || stat(path.c_str(), &st) != 0 || !S_ISREG(st.st_mode))
+                continue;
+
+            const auto cached = _cache.find(path);
+            CacheEntry current {st.st_ino, mtimeOf(st), st.st_size, PluginKind::NONE};
+            if (cached != _cache.end() && cached->second.inode == current.inode
+                && cached->second.mtime == current.mtime && cached->second.size == current.size) {
+                current.kind = cached->second.kind;
+            } else {
+                current.kind = inspect(path, st);
+                _cacheDirty = true;
+            }
+            seen[path] = current;
+            if (current.kind != PluginKind::NONE)
+                plugins.push_back({path, current.kind});
+        }
+        if (_cacheDirty || seen.size() != _cache.size()) {
+            _cache = std::move(seen);
+            saveCache();
+        }
+        std::sort(plugins.begin(), plugins.end(), [](const PluginInfo& a, const PluginInfo& b) {
+            return a.path < b.path;
+        });
+        return plugins;
+    }
+};
+
+#endif //PLUGINSCANNER_HPP
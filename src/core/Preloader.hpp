@@ -0,0 +1,173 @@
+/*
+**  _                                              _      ___    ___
+** | |                                            | |    |__ \  / _ \
+** | |_Created _       _ __   _ __    ___    __ _ | |__     ) || (_) |
+** | '_ \ | | | |     | '_ \ | '_ \  / _ \  / _` || '_ \   / /  \__, |
+** | |_) || |_| |     | | | || | | || (_) || (_| || | | | / /_    / /
+** |_.__/  \__, |     |_| |_||_| |_| \___/  \__,_||_| |_||____|  /_/
+**          __/ |     on 18/10/26.
+**         |___/
+*/
+
+#ifndef PRELOADER_HPP
+#define PRELOADER_HPP
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+#include "../games/IGame.hpp"
+#include "../graphicals/IGraphics.hpp"
+#include "../../includes/trace.hpp"
+#include <dlfcn.h>
+
+// Un jeu prêt à jouer : bibliothèque chargée, instance créée, graine posée, carte initialisée.
+struct GamePlugin {
+    std::string path;
+    void *handle = nullptr;
+    std::unique_ptr<Arcade::IGame> game;
+    unsigned int seed = 0;
+};
+
+// Une bibliothèque graphique résolue ; la fenêtre n'est créée qu'au moment
+// du changement, sur le thread qui la possédera.
+struct GraphicsLibrary {
+    std::string path;
+    void *handle = nullptr;
+    Arcade::IGraphics *(*factory)() = nullptr;
+};
+
+// Branche le plugin sur la trace du core s'il exporte setTraceSink
+inline void connectTrace(void *handle)
+{
+    if (void *setTraceSink = dlsym(handle, "setTraceSink"))
+        reinterpret_cast<void(*)(Arcade::ITraceSink*)>(setTraceSink)(Arcade::trace::sink().load());
+}
+
+// Un plugin sans getApiVersion() ou d'une autre version n'a pas la même
+// table virtuelle que le core : l'appeler planterait.
+inline void checkApiVersion(void *handle, const std::string& libPath)
+{
+    void *getApiVersion = dlsym(handle, "getApiVersion");
+    const unsigned int version = getApiVersion ? reinterpret_cast<unsigned int(*)()>(getApiVersion)() : 1;
+    if (version != Arcade::API_VERSION) {
+        dlclose(handle);
+        throw std::runtime_error(libPath + " was built for Arcade API " + std::to_string(version)
+            + ", expected " + std::to_string(Arcade::API_VERSION));
+    }
+}
+
+inline void *openLibrary(const std::string& libPath)
+{
+    Arcade::TraceZone zone("dlopen");
+    void *handle = dlopen(libPath.c_str(), RTLD_NOW | RTLD_LOCAL);
+    if (!handle) throw std::runtime_error(dlerror());
+    checkApiVersion(handle, libPath);
+    connectTrace(handle);
+    return handle;
+}
+
+inline GamePlugin openGame(const std::string& libPath, unsigned int seed)
+{
+    GamePlugin plugin;
+    plugin.path = libPath;
+    plugin.seed = seed;
+    plugin.handle = openLibrary(libPath);
+
+    void *createGame = dlsym(plugin.handle, "createGame");
+    if (!createGame) {
+        dlclose(plugin.handle);
+        throw std::runtime_error("Could not find symbol 'createGame' in " + libPath);
+    }
+
+    const auto gameFactory = reinterpret_cast<Arcade::IGame*(*)()>(createGame);
+    plugin.game.reset(gameFactory());
+    plugin.game->setSeed(seed);
+    plugin.game->initMap();
+    return plugin;
+}
+
+inline GraphicsLibrary openGraphics(const std::string& libPath)
+{
+    GraphicsLibrary library;
+    library.path = libPath;
+    library.handle = openLibrary(libPath);
+
+    void *createGraphics = dlsym(library.handle, "createGraphics");
+    if (!createGraphics) {
+        dlclose(library.handle);
+        throw std::runtime_error("Could not find symbol 'createGraphics' in " + libPath);
+    }
+    library.factory = reinterpret_cast<Arcade::IGraphics*(*)()>(createGraphics);
+    return library;
+}
+
+/*
+ * Thread de fond unique qui prépare le prochain jeu / la prochaine
+ * bibliothèque et démonte les anciens, pour qu'un changement ne fasse plus
+ * qu'échanger des pointeurs dans la boucle principale.
+ */
+class BackgroundWorker {
+private:
+    std::mutex _lock;
+    std::condition_variable _wakeUp;
+    std::deque<std::function<void()>> _tasks;
+    bool _stopping = false;
+    std::thread _thread;
+
+    void loop()
+    {
+        Arcade::trace::nameThread("preload");
+        while (true) {
+            std::function<void()> task;
+            {
+                std::unique_lock lock(_lock);
+                _wakeUp.wait(lock, [this] { return _stopping || !_tasks.empty(); });
+                if (_tasks.empty())
+                    return;
+                task = std::move(_tasks.front());
+                _tasks.pop_front();
+            }
+            task();
+        }
+    }
+
+public:
+    BackgroundWorker() : _thread([this] { loop(); }) {}
+
+    // Les tâches restantes sont exécutées avant l'arrêt.
+    ~BackgroundWorker()
+    {
+        {
+            std::lock_guard lock(_lock);
+            _stopping = true;
+        }
+        _wakeUp.notify_one();
+        _thread.join();
+    }
+
+    void submit(std::function<void()> task)
+    {
+        {
+            std::lock_guard lock(_lock);
+            _tasks.push_back(std::move(task));
+        }
+        _wakeUp.notify_one();
+    }
+
+    template <typename T>
+    std::future<T> run(std::function<T()> job)
+    {
+        auto task = std::make_shared<std::packaged_task<T()>>(std::move(job));
+        std::future<T> result = task->get_future();
+        submit([task] { (*task)(); });
+        return result;
+    }
+};
+
+#endif //PRELOADER_HPP
@@ -0,0 +1,182 @@
+/*
+**  _                                              _      ___    ___
+** | |                                            | |    |__ \  / _ \
+** | |_Created _       _ __   _ __    ___    __ _ | |__     ) || (_) |
+** | '_ \ | | | |     | '_ \ | '_ \  / _ \  / _` || '_ \   / /  \__, |
+** | |_) || |_| |     | | | || | | || (_) || (_| || | | | / /_    / /
+** |_.__/  \__, |     |_| |_||_| |_| \___/  \__,_||_| |_||____|  /_/
+**          __/ |     on 18/10/26.
+**         |___/
+*/
+
+#ifndef PROFILER_HPP
+#define PROFILER_HPP
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+enum class Phase {
+    INPUT,
+    UPDATE,
+    GET_MAP,
+    DRAW,
+    COUNT
+};
+
+inline const char *phaseName(Phase phase)
+{
+    switch (phase) {
+        case Phase::INPUT:   return "input";
+        case Phase::UPDATE:  return "update";
+        case Phase::GET_MAP: return "getMap";
+        case Phase::DRAW:    return "draw";
+        default:             return "?";
+    }
+}
+
+struct PhaseStats {
+    size_t samples = 0;
+    uint32_t p50 = 0;
+    uint32_t p99 = 0;
+    uint32_t max = 0;
+};
+
+/*
+ * Fenêtre glissante des WINDOW dernières durées d'une phase, en
+ * nanosecondes. Un seul thread écrit, l'overlay peut lire depuis un autre :
+ * les cases sont atomiques et une lecture concurrente voit au pire un
+ * mélange d'anciennes et de nouvelles mesures.
+ */
+class RollingHistogram {
+public:
+    static constexpr size_t WINDOW = 512;
+
+private:
+    std::array<std::atomic<uint32_t>, WINDOW> _samples {};
+    std::atomic<size_t> _count {0};
+
+public:
+    void add(uint32_t nanoseconds)
+    {
+        const size_t index = _count.load(std::memory_order_relaxed);
+        _samples[index % WINDOW].store(nanoseconds, std::memory_order_relaxed);
+        _count.store(index + 1, std::memory_order_release);
+    }
+
+    void clear()
+    {
+        _count.store(0, std::memory_order_release);
+    }
+
+    PhaseStats stats() const
+    {
+        PhaseStats result;
+        result.samples = std::min(_count.load(std::memory_order_acquire), WINDOW);
+        if (result.samples == 0)
+            return result;
+
+        std::array<uint32_t, WINDOW> sorted;
+        for (size_t i = 0; i < result.samples; ++i)
+            sorted[i] = _samples[i].load(std::memory_order_relaxed);
+        const auto begin = sorted.begin();
+        const auto end = begin + static_cast<std::ptrdiff_t>(result.samples);
+        const auto at = [&](size_t percent) {
+            const auto nth = begin + static_cast<std::ptrdiff_t>((result.samples - 1) * percent / 100);
+            std::nth_element(begin, nth, end);
+            return *nth;
+        };
+        result.p50 = at(50);
+        result.p99 = at(99);
+        result.max = *std::max_element(begin, end);
+        return result;
+    }
+};
+
+/*
+ * Chronométrage des phases de la boucle principale (entrées, update, copie
+ * de la carte, rendu). Désactivé, une mesure ne coûte qu'une lecture
+ * atomique ; F3 l'active et le résultat est affiché par le backend.
+ */
+class FrameProfiler {
+private:
+    using clock = std::chrono::steady_clock;
+
+    std::array<RollingHistogram, static_cast<size_t>(Phase::COUNT)> _phases;
+    std::atomic<bool> _enabled {false};
+
+public:
+    class Scope {
+    private:
+        RollingHistogram *_target;
+        clock::time_point _start;
+
+    public:
+        explicit Scope(RollingHistogram *target) : _target(target)
+        {
+            if (_target)
+                _start = clock::now();
+        }
+
+        ~Scope()
+        {
+            if (!_target)
+                return;
+            const auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(clock::now() - _start).count();
+            _target->add(static_cast<uint32_t>(std::min<long long>(elapsed, UINT32_MAX)));
+        }
+
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+    };
+
+    Scope measure(Phase phase)
+    {
+        return Scope(enabled() ? &_phases[static_cast<size_t>(phase)] : nullptr);
+    }
+
+    bool enabled() const
+    {
+        return _enabled.load(std::memory_order_relaxed);
+    }
+
+    void setEnabled(bool value)
+    {
+        if (value && !enabled()) {
+            for (auto& phase : _phases)
+                phase.clear();
+        }
+        _enabled.store(value, std::memory_order_relaxed);
+    }
+
+    void toggle()
+    {
+        setEnabled(!enabled());
+    }
+
+    PhaseStats stats(Phase phase) const
+    {
+        return _phases[static_cast<size_t>(phase)].stats();
+    }
+
+    // Une ligne par phase, durées en millisecondes
+    std::vector<std::string> overlay() const
+    {
+        std::vector<std::string> lines;
+        lines.emplace_back("phase       p50 ms   p99 ms   max ms");
+        for (size_t i = 0; i < static_cast<size_t>(Phase::COUNT); ++i) {
+            const PhaseStats s = _phases[i].stats();
+            char line[64];
+            std::snprintf(line, sizeof(line), "%-8s %8.3f %8.3f %8.3f", phaseName(static_cast<Phase>(i)),
+                s.p50 / 1e6, s.p99 / 1e6, s.max / 1e6);
+            lines.emplace_back(line);
+        }
+        return lines;
+    }
+};
+
+#endif //PROFILER_HPP
@@ -0,0 +1,136 @@
+/*
+**  _                                              _      ___    ___
+** | |                                            | |    |__ \  / _ \
+** | |_Created _       _ __   _ __    ___    __ _ | |__     ) || (_) |
+** | '_ \ | | | |     | '_ \ | '_ \  / _ \  / _` || '_ \   / /  \__, |
+** | |_) || |_| |     | | | || | | || (_) || (_| || | | | / /_    / /
+** |_.__/  \__, |     |_| |_||_| |_| \___/  \__,_||_| |_||____|  /_/
+**          __/ |     on 18/10/26.
+**         |___/
+*/
+
+#ifndef REPLAY_HPP
+#define REPLAY_HPP
+#include <deque>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+#include "../../includes/my.hpp"
+
+/*
+ * Format texte d'un enregistrement, une ligne par événement :
+ *   ARCADE-REPLAY 1
+ *   tickrate <pas par seconde>
+ *   seed <pas> <graine>        graine donnée au jeu chargé à ce pas
+ *   input <pas> <INPUT>        entrée consommée par ce pas
+ *   end <pas>                  nombre total de pas joués
+ * Les pas sans entrée ne sont pas écrits.
+ */
+class ReplayRecorder {
+private:
+    std::ofstream _file;
+
+public:
+    ReplayRecorder(const std::string& path, unsigned int tickRate) : _file(path)
+    {
+        if (!_file.is_open())
+            throw std::runtime_error("Could not open replay file for writing: " + path);
+        _file << "ARCADE-REPLAY 1\n" << "tickrate " << tickRate << '\n';
+    }
+
+    ~ReplayRecorder()
+    {
+        _file.flush();
+    }
+
+    void seed(size_t tick, unsigned int value)
+    {
+        _file << "seed " << tick << ' ' << value << '\n';
+    }
+
+    void input(size_t tick, Arcade::Input value)
+    {
+        if (value != Arcade::Input::NONE)
+            _file << "input " << tick << ' ' << Arcade::inputToString(value) << '\n';
+    }
+
+    void end(size_t tick)
+    {
+        _file << "end " << tick << '\n';
+    }
+};
+
+class ReplayPlayer {
+private:
+    struct Entry {
+        size_t tick;
+        Arcade::Input input;
+    };
+
+    unsigned int _tickRate = 60;
+    size_t _end = static_cast<size_t>(-1);
+    std::deque<unsigned int> _seeds;
+    std::deque<Entry> _inputs;
+
+public:
+    explicit ReplayPlayer(const std::string& path)
+    {
+        std::ifstream file(path);
+        if (!file.is_open())
+            throw std::runtime_error("Could not open replay file: " + path);
+
+        std::string line;
+        if (!std::getline(file, line) || line != "ARCADE-REPLAY 1")
+            throw std::runtime_error("Not a replay file: " + path);
+        while (std::getline(file, line)) {
+            std::istringstream words(line);
+            std::string kind;
+            size_t tick = 0;
+            words >> kind;
+            if (kind == "tickrate") {
+                words >> _tickRate;
+            } else if (kind == "seed") {
+                unsigned int value = 0;
+                words >> tick >> value;
+                _seeds.push_back(value);
+            } else if (kind == "input") {
+                std::string name;
+                words >> tick >> name;
+                _inputs.push_back({tick, Arcade::inputFromString(name)});
+            } else if (kind == "end") {
+                words >> _end;
+            }
+        }
+    }
+
+    unsigned int tickRate() const
+    {
+        return _tickRate;
+    }
+
+    unsigned int nextSeed()
+    {
+        if (_seeds.empty())
+            throw std::runtime_error("Replay has no seed left for the loaded game");
+        const unsigned int value = _seeds.front();
+        _seeds.pop_front();
+        return value;
+    }
+
+    Arcade::Input inputAt(size_t tick)
+    {
+        if (_inputs.empty() || _inputs.front().tick != tick)
+            return Arcade::Input::NONE;
+        const Arcade::Input input = _inputs.front().input;
+        _inputs.pop_front();
+        return input;
+    }
+
+    bool finished(size_t tick) const
+    {
+        return tick >= _end;
+    }
+};
+
+#endif //REPLAY_HPP
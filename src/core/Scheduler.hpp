@@ -0,0 +1,170 @@
+/*
+**  _                                              _      ___    ___
+** | |                                            | |    |__ \  / _ \
+** | |_Created _       _ __   _ __    ___    __ _ | |__     ) || (_) |
+** | '_ \ | | | |     | '_ \ | '_ \  / _ \  / _` || '_ \   / /  \__, |
+** | |_) || |_| |     | | | || | | || (_) || (_| || | | | / /_    / /
+** |_.__/  \__, |     |_| |_||_| |_| \___/  \__,_||_| |_||____|  /_/
+**          __/ |     on 18/10/26.
+**         |___/
+*/
+
+#ifndef SCHEDULER_HPP
+#define SCHEDULER_HPP
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstdlib>
+#include <string>
+#include <time.h>
+
+struct SchedulerConfig {
+    unsigned int tickRate = 60;         // Pas de simulation par seconde
+    unsigned int renderRate = 60;       // Images par seconde (0 = à chaque tour de boucle)
+    unsigned int maxCatchUpTicks = 5;   // Pas rattrapés au maximum après un retard
+    bool threaded = false;              // Simulation et rendu sur deux threads
+    bool uncapped = false;              // Un pas et une image par tour, sans jamais dormir
+
+    static unsigned int readRate(const char *name, unsigned int fallback)
+    {
+        const char *value = std::getenv(name);
+        if (!value || !*value)
+            return fallback;
+        try {
+            return static_cast<unsigned int>(std::stoul(value));
+        } catch (const std::exception&) {
+            return fallback;
+        }
+    }
+
+    static SchedulerConfig fromEnv()
+    {
+        SchedulerConfig config;
+        config.tickRate = std::max(1u, readRate("ARCADE_TICK_RATE", config.tickRate));
+        config.renderRate = readRate("ARCADE_RENDER_RATE", config.renderRate);
+        config.threaded = readRate("ARCADE_THREADED", 0) != 0;
+        config.uncapped = readRate("ARCADE_UNCAPPED", 0) != 0;
+        return config;
+    }
+};
+
+/*
+ * Horloge à pas fixe de la boucle principale : le temps réel écoulé est
+ * accumulé puis consommé par tranches de `tickDuration()`, le rendu suit sa
+ * propre cadence et le thread dort (clock_nanosleep absolu) jusqu'à la
+ * prochaine échéance au lieu de tourner à vide.
+ */
+class Scheduler {
+public:
+    using clock = std::chrono::steady_clock;
+
+private:
+    SchedulerConfig _config;
+    clock::duration _tickDuration;
+    clock::duration _renderDuration;
+    clock::duration _accumulator = clock::duration::zero();
+    clock::time_point _lastTime;
+    clock::time_point _nextRender;
+
+    static clock::duration periodOf(unsigned int rate)
+    {
+        if (rate == 0)
+            return clock::duration::zero();
+        return std::chrono::duration_cast<clock::duration>(std::chrono::nanoseconds(1'000'000'000 / rate));
+    }
+
+    static void sleepUntil(clock::time_point deadline)
+    {
+        const auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(deadline.time_since_epoch()).count();
+        timespec ts {};
+        ts.tv_sec = static_cast<time_t>(ns / 1'000'000'000);
+        ts.tv_nsec = static_cast<long>(ns % 1'000'000'000);
+        while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, nullptr) == EINTR);
+    }
+
+public:
+    explicit Scheduler(const SchedulerConfig& config = SchedulerConfig::fromEnv())
+        : _config(config), _tickDuration(periodOf(config.tickRate)), _renderDuration(periodOf(config.renderRate))
+    {
+        start();
+    }
+
+    void start()
+    {
+        _lastTime = clock::now();
+        _nextRender = _lastTime;
+        _accumulator = clock::duration::zero();
+    }
+
+    clock::duration tickDuration() const
+    {
+        return _tickDuration;
+    }
+
+    const SchedulerConfig& getConfig() const
+    {
+        return _config;
+    }
+
+    // Nombre de pas de simulation à exécuter maintenant ; le retard au-delà
+    // de maxCatchUpTicks est abandonné pour ne pas entrer en spirale.
+    size_t pendingTicks()
+    {
+        if (_config.uncapped)
+            return 1;
+        const auto now = clock::now();
+        _accumulator += now - _lastTime;
+        _lastTime = now;
+
+        size_t ticks = 0;
+        while (_accumulator >= _tickDuration && ticks < _config.maxCatchUpTicks) {
+            _accumulator -= _tickDuration;
+            ticks++;
+        }
+        if (_accumulator >= _tickDuration)
+            _accumulator = clock::duration::zero();
+        return ticks;
+    }
+
+    bool renderDue()
+    {
+        if (_config.uncapped)
+            return true;
+        const auto now = clock::now();
+        if (now < _nextRender)
+            return false;
+        _nextRender += _renderDuration;
+        if (_nextRender < now)
+            _nextRender = now + _renderDuration;
+        return true;
+    }
+
+    void sleepUntilNextEvent() const
+    {
+        if (_config.uncapped)
+            return;
+        const auto nextTick = _lastTime + (_tickDuration - _accumulator);
+        const auto deadline = _renderDuration == clock::duration::zero() ? nextTick : std::min(nextTick, _nextRender);
+        if (deadline > clock::now())
+            sleepUntil(deadline);
+    }
+
+    void sleepUntilNextTick() const
+    {
+        if (_config.uncapped)
+            return;
+        const auto deadline = _lastTime + (_tickDuration - _accumulator);
+        if (deadline > clock::now())
+            sleepUntil(deadline);
+    }
+
+    void sleepUntilNextRender() const
+    {
+        if (_config.uncapped)
+            return;
+        if (_nextRender > clock::now())
+            sleepUntil(_nextRender);
+    }
+};
+
+#endif //SCHEDULER_HPP
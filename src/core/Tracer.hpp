@@ -0,0 +1,222 @@
+/*
+**  _                                              _      ___    ___
+** | |                                            | |    |__ \  / _ \
+** | |_Created _       _ __   _ __    ___    __ _ | |__     ) || (_) |
+** | '_ \ | | | |     | '_ \ | '_ \  / _ \  / _` || '_ \   / /  \__, |
+** | |_) || |_| |     | | | || | | || (_) || (_| || | | | / /_    / /
+** |_.__/  \__, |     |_| |_||_| |_| \___/  \__,_||_| |_||____|  /_/
+**          __/ |     on 18/10/26.
+**         |___/
+*/
+
+#ifndef TRACER_HPP
+#define TRACER_HPP
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "../../includes/trace.hpp"
+
+/*
+ * Export des zones au format Chrome trace-event (chrome://tracing, Perfetto).
+ * Chaque thread remplit son propre tampon ; un thread d'écriture les vide
+ * périodiquement dans le fichier, si bien que la boucle de jeu ne fait
+ * jamais d'entrée/sortie. Les noms sont recopiés à l'enregistrement : une
+ * zone reste lisible même si le plugin qui l'a émise a été déchargé.
+ */
+class Tracer final : public Arcade::ITraceSink {
+private:
+    using clock = std::chrono::steady_clock;
+
+    static constexpr size_t NAME_SIZE = 48;
+    static constexpr auto FLUSH_PERIOD = std::chrono::milliseconds(100);
+
+    struct Event {
+        char name[NAME_SIZE];
+        int64_t start;
+        int64_t duration;
+    };
+
+    struct ThreadBuffer {
+        std::mutex lock;
+        std::vector<Event> events;
+        std::string threadName;
+        bool nameWritten = true;
+        uint32_t id = 0;
+    };
+
+    struct LocalBuffer {
+        const Tracer *owner = nullptr;
+        std::shared_ptr<ThreadBuffer> buffer;
+    };
+
+    std::ofstream _file;
+    clock::time_point _origin;
+    bool _firstEvent = true;
+
+    std::mutex _registryLock;
+    std::vector<std::shared_ptr<ThreadBuffer>> _buffers;
+
+    std::mutex _wakeLock;
+    std::condition_variable _wakeUp;
+    bool _stopping = false;
+    std::thread _writer;
+
+    ThreadBuffer& local()
+    {
+        thread_local LocalBuffer current;
+        if (current.owner != this) {
+            current.owner = this;
+            current.buffer = std::make_shared<ThreadBuffer>();
+            std::lock_guard lock(_registryLock);
+            current.buffer->id = static_cast<uint32_t>(_buffers.size() + 1);
+            _buffers.push_back(current.buffer);
+        }
+        return *current.buffer;
+    }
+
+    int64_t sinceOrigin(clock::time_point time) const
+    {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(time - _origin).count();
+    }
+
+    void separator()
+    {
+        if (!_firstEvent)
+            _file << ",\n";
+        _firstEvent = false;
+    }
+
+    void writeString(const char *text)
+    {
+        _file << '"';
+        for (; *text; ++text) {
+            if (*text == '"' || *text == '\\')
+                _file << '\\';
+            _file << *text;
+        }
+        _file << '"';
+    }
+
+    // Les horodatages Chrome sont en microsecondes
+    void writeEvent(const Event& event, uint32_t thread)
+    {
+        separator();
+        _file << "{\"name\":";
+        writeString(event.name);
+        _file << ",\"ph\":\"X\",\"pid\":1,\"tid\":" << thread
+              << ",\"ts\":" << event.start / 1000 << '.' << event.start % 1000 / 100
+              << ",\"dur\":" << event.duration / 1000 << '.' << event.duration % 1000 / 100 << '}';
+    }
+
+    void writeThreadName(const std::string& name, uint32_t thread)
+    {
+        separator();
+        _file << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << thread << ",\"args\":{\"name\":";
+        writeString(name.c_str());
+        _file << "}}";
+    }
+
+    void drain()
+    {
+        std::vector<std::shared_ptr<ThreadBuffer>> buffers;
+        {
+            std::lock_guard lock(_registryLock);
+            buffers = _buffers;
+        }
+        std::vector<Event> events;
+        for (const auto& buffer : buffers) {
+            std::string threadName;
+            {
+                std::lock_guard lock(buffer->lock);
+                events.swap(buffer->events);
+                if (!buffer->nameWritten)
+                    threadName = buffer->threadName;
+                buffer->nameWritten = true;
+            }
+            if (!threadName.empty())
+                writeThreadName(threadName, buffer->id);
+            for (const Event& event : events)
+                writeEvent(event, buffer->id);
+            events.clear();
+        }
+        _file.flush();
+    }
+
+    void loop()
+    {
+        std::unique_lock lock(_wakeLock);
+        while (!_stopping) {
+            _wakeUp.wait_for(lock, FLUSH_PERIOD, [this] { return _stopping; });
+            lock.unlock();
+            drain();
+            lock.lock();
+        }
+    }
+
+public:
+    explicit Tracer(const std::string& path) : _file(path), _origin(clock::now())
+    {
+        if (!_file.is_open())
+            throw std::runtime_error("Could not open trace file for writing: " + path);
+        _file << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+        _writer = std::thread([this] { loop(); });
+    }
+
+    ~Tracer() override
+    {
+        if (Arcade::trace::sink().load() == this)
+            Arcade::trace::setSink(nullptr);
+        {
+            std::lock_guard lock(_wakeLock);
+            _stopping = true;
+        }
+        _wakeUp.notify_one();
+        _writer.join();
+        drain();
+        _file << "\n]}\n";
+    }
+
+    // ARCADE_TRACE=<fichier> active la trace et en fait la destination du core
+    static std::unique_ptr<Tracer> fromEnv()
+    {
+        const char *path = std::getenv("ARCADE_TRACE");
+        if (!path || !*path)
+            return nullptr;
+        auto tracer = std::make_unique<Tracer>(path);
+        Arcade::trace::setSink(tracer.get());
+        return tracer;
+    }
+
+    void record(const char *name, clock::time_point start, clock::time_point end) override
+    {
+        Event event;
+        std::strncpy(event.name, name, NAME_SIZE - 1);
+        event.name[NAME_SIZE - 1] = '\0';
+        event.start = sinceOrigin(start);
+        event.duration = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+
+        ThreadBuffer& buffer = local();
+        std::lock_guard lock(buffer.lock);
+        buffer.events.push_back(event);
+    }
+
+    void nameThread(const char *name) override
+    {
+        ThreadBuffer& buffer = local();
+        std::lock_guard lock(buffer.lock);
+        buffer.threadName = name;
+        buffer.nameWritten = false;
+    }
+};
+
+#endif //TRACER_HPP
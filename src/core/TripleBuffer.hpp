@@ -0,0 +1,63 @@
+/*
+**  _                                              _      ___    ___
+** | |                                            | |    |__ \  / _ \
+** | |_Created _       _ __   _ __    ___    __ _ | |__     ) || (_) |
+** | '_ \ | | | |     | '_ \ | '_ \  / _ \  / _` || '_ \   / /  \__, |
+** | |_) || |_| |     | | | || | | || (_) || (_| || | | | / /_    / /
+** |_.__/  \__, |     |_| |_||_| |_| \___/  \__,_||_| |_||____|  /_/
+**          __/ |     on 18/10/26.
+**         |___/
+*/
+
+#ifndef TRIPLEBUFFER_HPP
+#define TRIPLEBUFFER_HPP
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+/*
+ * Triple buffer sans verrou entre un seul producteur et un seul consommateur.
+ * Le producteur remplit back() puis publish() ; le consommateur appelle
+ * update() et lit front(), qui reste stable jusqu'au prochain update().
+ * Aucun des deux ne bloque l'autre : le consommateur récupère toujours la
+ * dernière publication, les intermédiaires sont simplement écrasées.
+ */
+template <typename T>
+class TripleBuffer {
+private:
+    static constexpr uint8_t INDEX_MASK = 0x3;
+    static constexpr uint8_t FRESH_BIT = 0x4;
+
+    std::array<T, 3> _slots;
+    std::atomic<uint8_t> _middle {1};
+    uint8_t _back = 0;
+    uint8_t _front = 2;
+
+public:
+    explicit TripleBuffer(const T& initial) : _slots {initial, initial, initial} {}
+
+    T& back()
+    {
+        return _slots[_back];
+    }
+
+    void publish()
+    {
+        _back = _middle.exchange(_back | FRESH_BIT, std::memory_order_acq_rel) & INDEX_MASK;
+    }
+
+    bool update()
+    {
+        if (!(_middle.load(std::memory_order_relaxed) & FRESH_BIT))
+            return false;
+        _front = _middle.exchange(_front, std::memory_order_acq_rel) & INDEX_MASK;
+        return true;
+    }
+
+    const T& front() const
+    {
+        return _slots[_front];
+    }
+};
+
+#endif //TRIPLEBUFFER_HPP
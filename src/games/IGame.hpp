@@ -11,11 +11,13 @@
 
 #ifndef IGAME_HPP
 #define IGAME_HPP
+#include <chrono>
 #include <string>
 #include <vector>
 
 #include "../../includes/gameMap.hpp"
 #include  "../../includes/my.hpp"
+#include "../../includes/trace.hpp"
 
 
 namespace Arcade {
@@ -29,15 +31,27 @@ namespace Arcade {
         bool gameOver = false;
         size_t score = 0, level = 0;
         size_t mapHeight = 0, mapWidth = 0;
+        // Temps de simulation, avancé par le Core à chaque pas fixe
+        std::chrono::steady_clock::time_point simTime {};
     public:
         virtual ~IGame() = default;
+        void advanceClock(std::chrono::steady_clock::duration dt) { simTime += dt; }
         virtual void reset() = 0;
         virtual void initMap() = 0;
         virtual void update(Input userInput) = 0;
         virtual GameMap getMap() const = 0;
+        // Carte courante prêtée sans copie, valable jusqu'au prochain update()
+        virtual const GameMap& viewMap() const
+        {
+            static const GameMap empty(0, 0, 0);
+            return map ? *map : empty;
+        }
         virtual bool isGameOver() const = 0;
         virtual int getScore() const = 0;
         virtual std::string getName() const = 0;
+        // Réinitialise les générateurs aléatoires du jeu puis la partie,
+        // pour qu'une même graine et les mêmes entrées donnent la même partie.
+        virtual void setSeed(unsigned int seed) { (void)seed; }
     };
 
 } // namespace Arcade
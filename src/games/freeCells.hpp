@@ -0,0 +1,153 @@
+/*
+**  _                                              _      ___    ___
+** | |                                            | |    |__ \  / _ \
+** | |_Created _       _ __   _ __    ___    __ _ | |__     ) || (_) |
+** | '_ \ | | | |     | '_ \ | '_ \  / _ \  / _` || '_ \   / /  \__, |
+** | |_) || |_| |     | | | || | | || (_) || (_| || | | | / /_    / /
+** |_.__/  \__, |     |_| |_||_| |_| \___/  \__,_||_| |_||____|  /_/
+**          __/ |     on 18/10/26.
+**         |___/
+*/
+
+#ifndef FREECELLS_HPP
+#define FREECELLS_HPP
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+namespace Arcade
+{
+    /*
+     * Cases libres de l'intérieur d'un plateau entouré de murs, pour poser
+     * la nourriture en un seul tirage.
+     *
+     * Les cases intérieures forment une permutation : les size() premières
+     * entrées de _dense sont les cases libres, les autres les cases prises,
+     * et _back donne la position de chaque case dans _dense. Prendre une
+     * case l'échange avec la dernière libre, la rendre l'échange avec la
+     * première prise : tout est en temps constant.
+     *
+     * Les deux tableaux sont découpés en pages allouées à la première
+     * écriture ; une page jamais écrite vaut l'identité. Sur un plateau de
+     * 10000x10000, seules les pages dérangées par le serpent coûtent de la
+     * mémoire.
+     */
+    class FreeCells {
+        private:
+            static constexpr size_t PAGE_SHIFT = 12;
+            static constexpr size_t PAGE_SIZE = size_t {1} << PAGE_SHIFT;
+
+            // Tableau d'indices qui vaut i en i tant qu'on n'y a pas écrit
+            class IdentityArray {
+                private:
+                    using Page = std::array<uint32_t, PAGE_SIZE>;
+                    std::vector<std::unique_ptr<Page>> _pages;
+
+                public:
+                    void reset(size_t count)
+                    {
+                        _pages.clear();
+                        _pages.resize((count + PAGE_SIZE - 1) >> PAGE_SHIFT);
+                    }
+
+                    uint32_t get(size_t i) const
+                    {
+                        const Page *page = _pages[i >> PAGE_SHIFT].get();
+                        return page ? (*page)[i & (PAGE_SIZE - 1)] : static_cast<uint32_t>(i);
+                    }
+
+                    void set(size_t i, uint32_t value)
+                    {
+                        std::unique_ptr<Page>& page = _pages[i >> PAGE_SHIFT];
+                        if (!page) {
+                            page = std::make_unique<Page>();
+                            const uint32_t base = static_cast<uint32_t>(i & ~(PAGE_SIZE - 1));
+                            for (size_t j = 0; j < PAGE_SIZE; ++j)
+                                (*page)[j] = base + static_cast<uint32_t>(j);
+                        }
+                        (*page)[i & (PAGE_SIZE - 1)] = value;
+                    }
+            };
+
+            size_t _width = 0;
+            size_t _inner = 0;
+            size_t _size = 0;
+            IdentityArray _dense;
+            IdentityArray _back;
+
+            size_t slotOf(size_t x, size_t y) const { return (y - 1) * _inner + (x - 1); }
+
+            void place(size_t position, uint32_t slot)
+            {
+                _dense.set(position, slot);
+                _back.set(slot, static_cast<uint32_t>(position));
+            }
+
+            void swap(size_t a, size_t b)
+            {
+                const uint32_t first = _dense.get(a);
+                const uint32_t second = _dense.get(b);
+                place(a, second);
+                place(b, first);
+            }
+
+        public:
+            // Toutes les cases intérieures de width x height redeviennent libres
+            void reset(size_t width, size_t height)
+            {
+                if (width < 3 || height < 3)
+                    throw std::runtime_error("Board too small for free cells");
+                if ((width - 2) * (height - 2) > UINT32_MAX)
+                    throw std::runtime_error("Board too large for free cells");
+                _width = width;
+                _inner = width - 2;
+                _size = _inner * (height - 2);
+                _dense.reset(_size);
+                _back.reset(_size);
+            }
+
+            size_t size() const { return _size; }
+            bool empty() const { return _size == 0; }
+
+            bool contains(size_t x, size_t y) const
+            {
+                return _back.get(slotOf(x, y)) < _size;
+            }
+
+            // Marque la case prise ; sans effet si elle l'était déjà
+            void remove(size_t x, size_t y)
+            {
+                const size_t position = _back.get(slotOf(x, y));
+                if (position >= _size)
+                    return;
+                _size--;
+                if (position != _size)
+                    swap(position, _size);
+            }
+
+            // Rend la case ; sans effet si elle était déjà libre
+            void insert(size_t x, size_t y)
+            {
+                const size_t position = _back.get(slotOf(x, y));
+                if (position < _size)
+                    return;
+                if (position != _size)
+                    swap(position, _size);
+                _size++;
+            }
+
+            // Case libre tirée uniformément, en indice de carte (y * width + x).
+            // Le plateau ne doit pas être plein.
+            size_t pick(std::mt19937& rng) const
+            {
+                std::uniform_int_distribution<size_t> draw(0, _size - 1);
+                const size_t slot = _dense.get(draw(rng));
+                return (slot / _inner + 1) * _width + slot % _inner + 1;
+            }
+    };
+}
+
+#endif //FREECELLS_HPP
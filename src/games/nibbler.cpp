@@ -41,15 +41,28 @@ namespace Arcade {
         size_t startX = mapWidth / 2;
         size_t startY = mapHeight / 2;
 
-        m_nibbler.clear();
+        m_nibbler.reset(mapWidth, mapHeight);
+        m_dirty.clear();
+
+        // Cases libres reconstruites ici et non dans initMap(), que le
+        // préchargement rappelle après reset() : les piliers viennent de la carte
+        m_free.reset(mapWidth, mapHeight);
+        for (size_t y = 1; y < mapHeight - 1; ++y) {
+            for (size_t x = 1; x < mapWidth - 1; ++x) {
+                if (map->getEntity(x, y) == EntityType::WALL)
+                    m_free.remove(x, y);
+            }
+        }
 
         for (size_t i = 0; i < INITIAL_NIBBLER_SIZE; ++i) {
-            m_nibbler.push_back({startX - i, startY});
+            m_nibbler.pushTail({startX - i, startY});
+            m_free.remove(startX - i, startY);
+            m_dirty.push_back({startX - i, startY});
         }
 
         if (startX < INITIAL_NIBBLER_SIZE + 2) startX = INITIAL_NIBBLER_SIZE + 2;
         
-        m_lastUpdateTime = std::chrono::steady_clock::now();
+        m_lastUpdateTime = simTime;
         
         spawnFood();
         
@@ -83,6 +96,14 @@ namespace Arcade {
                 if (cell) cell->entity = EntityType::WALL;
             }
         }
+
+        // Carte vidée : une partie en cours (préchargement après reset())
+        // repeint son corps et sa nourriture au prochain updateMap()
+        if (!m_nibbler.empty()) {
+            for (const NibblerPart segment : m_nibbler)
+                m_dirty.push_back(segment);
+            m_dirty.push_back(m_food);
+        }
     }
 
     void Nibbler::update(Input userInput)
@@ -123,7 +144,7 @@ namespace Arcade {
                 break;
         }
         
-        auto currentTime = std::chrono::steady_clock::now();
+        auto currentTime = simTime;
         auto elapsedTime = std::chrono::duration_cast<std::chrono::milliseconds>(
             currentTime - m_lastUpdateTime).count();
         
@@ -138,9 +159,10 @@ namespace Arcade {
 
     void Nibbler::moveNibbler()
     {
+        TraceZone zone("Nibbler::moveNibbler");
         m_direction = m_nextDirection;
         
-        NibblerPart head = m_nibbler.front();
+        NibblerPart head = m_nibbler.head();
         
         NibblerPart newHead = head;
         
@@ -168,22 +190,18 @@ namespace Arcade {
             return;
         }
         
-        bool collidesWithBody = false;
-        auto it = std::next(m_nibbler.begin());
-
-        for (; it != m_nibbler.end(); ++it) {
-            if (newHead.x == it->x && newHead.y == it->y) {
-                collidesWithBody = true;
-                break;
-            }
-        }
+        // Tout le corps sauf la tête, queue comprise
+        const bool collidesWithBody = m_nibbler.occupied(newHead.x, newHead.y)
+            && (newHead.x != head.x || newHead.y != head.y);
 
         if (collidesWithBody) {
             gameOver = true;
             return;
         }
         
-        m_nibbler.push_front(newHead);
+        m_nibbler.pushHead(newHead);
+        m_free.remove(newHead.x, newHead.y);
+        m_dirty.push_back(newHead);
         
         if (newHead.x == m_food.x && newHead.y == m_food.y) {
             score += 10;
@@ -200,62 +218,41 @@ namespace Arcade {
                 }
             }
         } else {
-            m_nibbler.pop_back();
+            m_free.insert(m_nibbler.tail().x, m_nibbler.tail().y);
+            m_dirty.push_back(m_nibbler.tail());
+            m_nibbler.popTail();
         }
     }
 
     void Nibbler::spawnFood()
     {
-        std::uniform_int_distribution<size_t> distX(1, mapWidth - 2);
-        std::uniform_int_distribution<size_t> distY(1, mapHeight - 2);
-        
-        do {
-            m_food.x = distX(m_rng);
-            m_food.y = distY(m_rng);
-            Cell* foodCell = map->getCell(m_food.x, m_food.y);
-            
-            if (foodCell && foodCell->entity == EntityType::WALL) continue;
-            if (checkCollision(m_food.x, m_food.y)) continue;
-            
-            break;
-        } while (true);
-    }
-
-    bool Nibbler::checkCollision(size_t x, size_t y) const
-    {
-        for (const auto& segment : m_nibbler) {
-            if (segment.x == x && segment.y == y) {
-                return true;
-            }
+        // Un seul tirage parmi les cases libres (ni mur, ni corps). Plus
+        // aucune : le plateau est plein, le niveau est gagné.
+        if (m_free.empty()) {
+            gameWon = true;
+            return;
         }
-        return false;
+        const size_t cell = m_free.pick(m_rng);
+        m_food.x = cell % mapWidth;
+        m_food.y = cell / mapWidth;
+        m_free.remove(m_food.x, m_food.y);
+        m_dirty.push_back(m_food);
     }
 
     void Nibbler::updateMap()
     {
-        for (size_t y = 1; y < mapHeight - 1; y++) {
-            for (size_t x = 1; x < mapWidth - 1; x++) {
-                Cell* cell = map->getCell(x, y);
-                if (cell && cell->entity != EntityType::WALL) 
-                    cell->entity = EntityType::EMPTY;
-            }
-        }
-        
-        Cell* foodCell = map->getCell(m_food.x, m_food.y);
-        if (foodCell) foodCell->entity = EntityType::BONUS;
-        
-        bool isHead = true;
-        for (const auto& segment : m_nibbler) {
-            Cell* nibblerCell = map->getCell(segment.x, segment.y);
-            if (nibblerCell) {
-                if (isHead) {
-                    nibblerCell->entity = EntityType::PLAYER;
-                    isHead = false;
-                } else {
-                    nibblerCell->entity = EntityType::PLAYER;
-                }
-            }
+        // Seules les cases touchées depuis le dernier tour sont réécrites :
+        // nouvelle tête, ancienne queue, nourriture (tout le corps après un
+        // redémarrage, la carte venant d'être vidée)
+        for (const NibblerPart cell : m_dirty) {
+            EntityType type = EntityType::EMPTY;
+            if (m_nibbler.occupied(cell.x, cell.y))
+                type = EntityType::PLAYER;
+            else if (cell.x == m_food.x && cell.y == m_food.y)
+                type = EntityType::BONUS;
+            map->setCell(cell.x, cell.y, type);
         }
+        m_dirty.clear();
         
         map->setScore(score);
         map->setLevel(level);
@@ -265,11 +262,11 @@ namespace Arcade {
             map->setMessage("Game Over! Press R to restart");
         } else if (gameWon) {
             map->setMessage("Level completed! Press SPACE to continue or R to restart");
-            map->setFlag("VICTORY", true);
+            map->setFlag(MapFlag::VICTORY, true);
         } else {
             std::string msg = "Food remaining: " + std::to_string(m_remainingFood);
             map->setMessage(msg);
-            map->setFlag("VICTORY", false);
+            map->setFlag(MapFlag::VICTORY, false);
         }
     }
 
@@ -295,10 +292,24 @@ namespace Arcade {
     {
         return name;
     }
+
+    void Nibbler::setSeed(unsigned int seed)
+    {
+        m_rng.seed(seed);
+        reset();
+    }
 }
 
 extern "C" {
     Arcade::IGame* createGame() {
         return new Arcade::Nibbler();
     }
+
+    unsigned int getApiVersion() {
+        return Arcade::API_VERSION;
+    }
+
+    void setTraceSink(Arcade::ITraceSink *sink) {
+        Arcade::trace::setSink(sink);
+    }
 }
\ No newline at end of file
@@ -1,18 +1,17 @@
 #ifndef NIBBLER_HPP
 #define NIBBLER_HPP
 
-#include <deque>
 #include <random>
 #include <chrono>
+#include <vector>
 #include "IGame.hpp"
+#include "freeCells.hpp"
+#include "snakeBody.hpp"
 #include <memory>
 
 namespace Arcade {
 
-    struct NibblerPart {
-        size_t x;
-        size_t y;
-    };
+    using NibblerPart = SnakePart;
 
     class Nibbler : public IGame {
     private:
@@ -21,7 +20,9 @@ namespace Arcade {
         static constexpr size_t INITIAL_NIBBLER_SIZE = 4;
         static constexpr size_t INITIAL_SPEED = 200;
         
-        std::deque<NibblerPart> m_nibbler;
+        SnakeBody m_nibbler;
+        FreeCells m_free;
+        std::vector<NibblerPart> m_dirty;
         Input m_direction;
         Input m_nextDirection;
 
@@ -37,7 +38,6 @@ namespace Arcade {
         void moveNibbler();
         void nextLevel();
         void spawnFood();
-        bool checkCollision(size_t x, size_t y) const;
         void updateMap();
         
     public:
@@ -51,6 +51,7 @@ namespace Arcade {
         bool isGameOver() const override;
         int getScore() const override;
         std::string getName() const override;
+        void setSeed(unsigned int seed) override;
     };
 }
 
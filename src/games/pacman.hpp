@@ -16,6 +16,7 @@
 
 #include "AGame.hpp"
 #include "../../includes/my.hpp"
+#include "../../includes/levelFile.hpp"
 
 #define FILEPATH_LEVEL_1 "./lib/pacman_assets/level1.map"
 namespace Arcade
@@ -36,15 +37,17 @@ namespace Arcade
     private:
         position pos;
         GhostState state_ = GhostState::SCATTER;
-        EntityType lastCellEntity = EntityType::EMPTY;
+        // Acteur du fantôme sur la carte : la gomme qu'il survole reste dans
+        // la couche des objets, il n'a rien à garder ni à rendre
+        uint32_t actor = 0;
         std::chrono::steady_clock::time_point fearStartTime;
         std::chrono::steady_clock::time_point huntStartTime;
         bool isFearful = false;
         bool isHunter = false;
         bool atHome = true;
+        int currentDir = random(1, 4);
 
-        void updateState() {
-            const auto now = std::chrono::steady_clock::now();
+        void updateState(std::chrono::steady_clock::time_point now) {
             if (isFearful) {
                 const auto elapsed = std::chrono::duration_cast<std::chrono::seconds>(now - fearStartTime).count();
                 if (elapsed >= 10) {
@@ -61,28 +64,36 @@ namespace Arcade
             }
         }
 
-        void move(position new_pos, Cell *new_cell, GameMap *map) {
-            map->getCell(pos.x, pos.y)->entity = lastCellEntity;
-            lastCellEntity = new_cell->entity;
-            new_cell->entity = EntityType::ENEMY;
+        void move(position new_pos, GameMap *map) {
+            map->moveActor(actor, new_pos.x, new_pos.y);
             pos = new_pos;
         }
+
+        static bool canEnter(const GameMap *map, position cell, bool avoidGhosts) {
+            if (cell.x >= map->getWidth() || cell.y >= map->getHeight())
+                return false;
+            if (map->getTerrain(cell.x, cell.y) == Arcade::EntityType::WALL)
+                return false;
+            return !avoidGhosts || map->getEntity(cell.x, cell.y) != Arcade::EntityType::ENEMY;
+        }
     public:
         Ghost() : pos(1, 2) {}
 
+        void spawn(GameMap *map, position start) {
+            pos = start;
+            actor = map->addActor(start.x, start.y, EntityType::ENEMY);
+        }
+
         position getPosition() const {
             return pos;
         }
 
         void move_random(GameMap *map)
         {
-            // Direction actuelle, sauvegardée statiquement entre les appels
-            static int current_dir = random(1, 4);
-
             for (int attempts = 0; attempts < 4; ++attempts) {
                 position new_pos = pos;
 
-                switch (current_dir) {
+                switch (currentDir) {
                     case 1: new_pos.y--; break; // Haut
                     case 2: new_pos.x++; break; // Droite
                     case 3: new_pos.x--; break; // Gauche
@@ -90,15 +101,13 @@ namespace Arcade
                     default: break;
                 }
 
-                Cell *new_cell = map->getCell(new_pos.x, new_pos.y);
-
                 // Si la cellule est valide, on bouge
-                if (new_cell && new_cell->entity != Arcade::EntityType::WALL && new_cell->entity != Arcade::EntityType::ENEMY) {
-                    move(new_pos, new_cell, map);
+                if (canEnter(map, new_pos, true)) {
+                    move(new_pos, map);
                     return;
                 }
                 // Sinon, on choisit une nouvelle direction au hasard
-                current_dir = random(1, 4);
+                currentDir = random(1, 4);
             }
         }
 
@@ -107,22 +116,20 @@ namespace Arcade
             const int dx = (player.x > pos.x) ? 1 : (player.x < pos.x) ? -1 : 0;
             const int dy = (player.y > pos.y) ? 1 : (player.y < pos.y) ? -1 : 0;
 
-            bool move_in_x = (std::rand() % 2 == 0);
+            bool move_in_x = (random(0, 1) == 0);
 
             for (int i = 0; i < 2; ++i) {
                 if (move_in_x && dx != 0) {
-                    const size_t new_x = pos.x + dx;
-                    Cell *new_cell = map->getCell(new_x, pos.y);
-                    if (new_cell && new_cell->entity != Arcade::EntityType::WALL) {
-                        move({new_x, pos.y}, new_cell, map);
+                    const position next = {pos.x + dx, pos.y};
+                    if (canEnter(map, next, false)) {
+                        move(next, map);
                         return;
                     }
                 }
                 if (!move_in_x && dy != 0) {
-                    const size_t new_y = pos.y + dy;
-                    Cell *new_cell = map->getCell(pos.x, new_y);
-                    if (new_cell && new_cell->entity != Arcade::EntityType::WALL) {
-                        move({pos.x, new_y}, new_cell, map);
+                    const position next = {pos.x, pos.y + dy};
+                    if (canEnter(map, next, false)) {
+                        move(next, map);
                         return;
                     }
                 }
@@ -135,22 +142,20 @@ namespace Arcade
             const int dx = (player.x > pos.x) ? -1 : (player.x < pos.x) ? 1 : 0;
             const int dy = (player.y > pos.y) ? -1 : (player.y < pos.y) ? 1 : 0;
 
-            bool move_in_x = (std::rand() % 2 == 0);
+            bool move_in_x = (random(0, 1) == 0);
 
             for (int i = 0; i < 2; ++i) {
                 if (move_in_x && dx != 0) {
-                    const size_t new_x = pos.x + dx;
-                    Cell *new_cell = map->getCell(new_x, pos.y);
-                    if (new_cell && new_cell->entity != Arcade::EntityType::WALL && new_cell->entity != Arcade::EntityType::ENEMY) {
-                        move({new_x, pos.y}, new_cell, map);
+                    const position next = {pos.x + dx, pos.y};
+                    if (canEnter(map, next, true)) {
+                        move(next, map);
                         return;
                     }
                 }
                 if (!move_in_x && dy != 0) {
-                    const size_t new_y = pos.y + dy;
-                    Cell *new_cell = map->getCell(pos.x, new_y);
-                    if (new_cell && new_cell->entity != Arcade::EntityType::WALL && new_cell->entity != Arcade::EntityType::ENEMY) {
-                        move({pos.x, new_y}, new_cell, map);
+                    const position next = {pos.x, pos.y + dy};
+                    if (canEnter(map, next, true)) {
+                        move(next, map);
                         return;
                     }
                 }
@@ -159,14 +164,14 @@ namespace Arcade
             move_random(map);
         }
 
-        void setState(GhostState state) {
+        void setState(GhostState state, std::chrono::steady_clock::time_point now) {
             state_ = state;
             if (state_ == GhostState::FEARFUL) {
-                fearStartTime = std::chrono::steady_clock::now();
+                fearStartTime = now;
                 isFearful = true;
             }
             if (state_ == GhostState::HUNTER) {
-                huntStartTime = std::chrono::steady_clock::now();
+                huntStartTime = now;
                 isHunter = true;
             }
         };
@@ -179,11 +184,8 @@ namespace Arcade
             atHome = true;
         }
 
-        void setPosition(position new_pos) {
-            pos = new_pos;
-        }
-
         void update(GameMap *map, position player) {
+            Arcade::TraceZone zone("Ghost::update");
             if (atHome)
                 return;
             if (state_ == GhostState::HUNTER)
@@ -207,17 +209,13 @@ namespace Arcade
         size_t lives = 3;
         size_t score = 0;
         std::chrono::steady_clock::time_point bigPacmanStartTime;
+        uint32_t actor = 0;
 
-        // void move(position new_pos, Cell *new_cell, GameMap *map) {
-        //     map->getCell(pos.x, pos.y)->entity = lastCellEntity;
-        //     lastCellEntity = new_cell->entity;
-        //     new_cell->entity = EntityType::ENEMY;
-        //     pos = new_pos;
-        // }
-        void move(position new_pos, Cell *new_cell, GameMap *map) {
-            map->getCell(pos.x, pos.y)->entity = EntityType::EMPTY;
+        // Mange la gomme de la case d'arrivée, puis s'y déplace
+        void move(position new_pos, GameMap *map) {
+            map->setItem(new_pos.x, new_pos.y, EntityType::EMPTY);
+            map->moveActor(actor, new_pos.x, new_pos.y);
             pos = new_pos;
-            new_cell->entity = EntityType::PLAYER;
         }
     public:
 
@@ -233,6 +231,13 @@ namespace Arcade
             pos = new_pos;
         }
 
+        // Retour au point de départ après une mort : vies et score sont gardés
+        void respawn(GameMap *map, position start) {
+            pos = start;
+            bigPacman = false;
+            actor = map->addActor(start.x, start.y, EntityType::PLAYER);
+        }
+
         size_t getLives() const{
             return lives;
         }
@@ -249,9 +254,8 @@ namespace Arcade
             return score;
         }
 
-        void update(Arcade::Input userInput, GameMap *map, Arcade::Input &lastInput)
+        void update(Arcade::Input userInput, GameMap *map, Arcade::Input &lastInput, std::chrono::steady_clock::time_point now)
         {
-            const auto now = std::chrono::steady_clock::now();
             if (bigPacman) {
                 const auto elapsed = std::chrono::duration_cast<std::chrono::seconds>(now - bigPacmanStartTime).count();
                 if (elapsed >= 10) {
@@ -270,25 +274,25 @@ namespace Arcade
                 default: return;
             }
 
-            Cell *new_cell = map->getCell(new_pos.x, new_pos.y);
-            if (!new_cell) return;
-            if (new_cell->entity == Arcade::EntityType::WALL) return;
+            if (new_pos.x >= map->getWidth() || new_pos.y >= map->getHeight()) return;
+            if (map->getTerrain(new_pos.x, new_pos.y) == Arcade::EntityType::WALL) return;
             lastInput = userInput;
 
-            if (new_cell->entity == Arcade::EntityType::ENEMY) {
+            if (map->getEntity(new_pos.x, new_pos.y) == Arcade::EntityType::ENEMY) {
                 if (bigPacman)
                     score += 200;
                 else
                     lives--;
             }
-            if (new_cell->entity == Arcade::EntityType::BONUS)
+            const Arcade::EntityType item = map->getItem(new_pos.x, new_pos.y);
+            if (item == Arcade::EntityType::BONUS)
                 score += 10;
-            if (new_cell->entity == Arcade::EntityType::BIG_BONUS) {
+            if (item == Arcade::EntityType::BIG_BONUS) {
                 bigPacman = true;
                 score += 10;
-                bigPacmanStartTime = std::chrono::steady_clock::now();
+                bigPacmanStartTime = now;
             }
-            move(new_pos, new_cell, map);
+            move(new_pos, map);
         }
 
     };
@@ -298,59 +302,89 @@ namespace Arcade
         Arcade::Input lastInput = Arcade::Input::LEFT;
         Pacman player;
         Ghost ghosts[4];
-        std::chrono::steady_clock::time_point lastPlayerMove = std::chrono::steady_clock::now();
-        std::chrono::steady_clock::time_point lastGhostMove = std::chrono::steady_clock::now();
+        std::chrono::steady_clock::time_point lastPlayerMove {};
+        std::chrono::steady_clock::time_point lastGhostMove {};
+        std::shared_ptr<const Level> level;
+
+        // Remet la grille et les acteurs dans l'état d'origine du niveau
+        void restartLevel() {
+            applyLevel(*map, *level);
+            lastInput = Arcade::Input::LEFT;
+            lastPlayerMove = {};
+            lastGhostMove = {};
 
+            size_t ghostIndex = 0;
+            bool pacmanPlaced = false;
+            for (const LevelSpawn &spawn : level->spawns) {
+                if (spawn.entity == Arcade::EntityType::PLAYER && !pacmanPlaced) {
+                    player.respawn(map.get(), {spawn.x, spawn.y});
+                    pacmanPlaced = true;
+                }
+                if (spawn.entity == Arcade::EntityType::ENEMY && ghostIndex < 4) {
+                    ghosts[ghostIndex] = Ghost();
+                    ghosts[ghostIndex].spawn(map.get(), {spawn.x, spawn.y});
+                    ghostIndex++;
+                }
+            }
+            if (!pacmanPlaced)
+                std::cerr << "Erreur: Pac-Man n'a pas été placé sur la carte !" << std::endl;
+            if (ghostIndex < 4)
+                std::cerr << "Avertissement: Seulement " << ghostIndex << " fantômes placés sur 4 !" << std::endl;
+            for (auto &ghost : ghosts)
+                ghost.quitHome();
+        }
 
     public:
         GamePacman(): AGame() {
             name = "Pacman";
             map->setImagePathsDirectory("./lib/pacman_assets/img/");
         };
-        void reset() override{
-            return;
+        void reset() override {
+            gameOver = false;
+            gameWon = false;
+            player = Pacman();
+            map->setMessage("");
+            map->setFlag(MapFlag::VICTORY, false);
+            initMap();
+            map->setLives(player.getLives());
+            map->setScore(player.getScore());
         };
 
+        void setSeed(unsigned int seed) override {
+            seedRandom(seed);
+            for (auto &ghost : ghosts)
+                ghost = Ghost();
+        }
+
         static bool isCollision(const position &a, const position &b) {
             return a.x == b.x && a.y == b.y;
         }
 
+        // Gommes restantes, y compris celles recouvertes par un fantôme
+        size_t remainingBonuses() const {
+            return map->countItems(EntityType::BONUS) + map->countItems(EntityType::BIG_BONUS);
+        }
+
         void initMap() override
         {
-            map->chargeMap(FILEPATH_LEVEL_1);
-            map->afficherMap();
-            size_t ghostIndex = 0;
-            bool pacmanPlaced = false;
-
-            for (size_t i = 0; i < map->getHeight(); ++i) {
-                for (size_t j = 0; j < map->getWidth(); ++j) {
-                    const Arcade::Cell* cell = map->getCell(j, i);
-                    if (!cell) continue;
-                    if (cell->entity == Arcade::EntityType::PLAYER && !pacmanPlaced) {
-                        player.setPosition({j, i});
-                        pacmanPlaced = true;
-                    }
-                    if (cell->entity == Arcade::EntityType::ENEMY && ghostIndex < 4) {
-                        ghosts[ghostIndex].setPosition({j, i});
-                        ghostIndex++;
-                    }
-                }
-            }
-            if (!pacmanPlaced)
-                std::cerr << "Erreur: Pac-Man n'a pas été placé sur la carte !" << std::endl;
-            if (ghostIndex < 4)
-                std::cerr << "Avertissement: Seulement " << ghostIndex << " fantômes placés sur 4 !" << std::endl;
-            for (auto &ghost : ghosts)
-                ghost.quitHome();
+            if (!level)
+                level = cachedLevel(FILEPATH_LEVEL_1);
+            restartLevel();
         }
 
         void update(Arcade::Input userInput) override
         {
-            const auto now = std::chrono::steady_clock::now();
+            if (userInput == Arcade::Input::RESTART) {
+                reset();
+                return;
+            }
+            if (gameOver || gameWon)
+                return;
+            const auto now = simTime;
             bool playerMoved = false;
 
             if (userInput != Arcade::Input::NONE || std::chrono::duration_cast<std::chrono::milliseconds>(now - lastPlayerMove).count() >= 500) {
-                player.update(userInput, map.get(), lastInput);
+                player.update(userInput, map.get(), lastInput, now);
                 lastPlayerMove = now;
                 playerMoved = true;
             }
@@ -359,20 +393,26 @@ namespace Arcade
             if (std::chrono::duration_cast<std::chrono::milliseconds>(now - lastGhostMove).count() >= 300) {
                 for (auto &ghost : ghosts) {
                     if (player.ifBigPacman())
-                        ghost.setState(GhostState::FEARFUL);
+                        ghost.setState(GhostState::FEARFUL, now);
 
                     ghost.update(map.get(), playerPos);
 
                     if (isCollision(playerPos, ghost.getPosition())) {
                         if (ghost.getState() == GhostState::FEARFUL) {
-                            ghost.setState(GhostState::EATEN);
+                            ghost.setState(GhostState::EATEN, now);
                             ghost.returnAtHome();
                             player.addScores(200);
                         } else if (ghost.getState() != GhostState::EATEN) {
                             player.losesLives();
-                            reset();
-                            if (player.getLives() <= 0)
+                            if (player.getLives() <= 0) {
                                 gameOver = true;
+                                map->setLives(0);
+                                map->setGameOver(true);
+                                map->setMessage("Game Over! Press R to restart");
+                            } else {
+                                restartLevel();
+                                map->setLives(player.getLives());
+                            }
                             return;
                         }
                     }
@@ -381,6 +421,11 @@ namespace Arcade
             }
             map->setLives(player.getLives());
             map->setScore(player.getScore());
+            if (remainingBonuses() == 0) {
+                gameWon = true;
+                map->setMessage("Victory!");
+                map->setFlag(MapFlag::VICTORY, true);
+            }
             // map->afficherMap();
             if (playerMoved) std::cout << "Updating Pacman" << std::endl;
         }
@@ -1,8 +1,21 @@
 #include "snake.hpp"
-#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
 #include <iostream>
 
 namespace Arcade {
+    // ARCADE_SNAKE_SIZE=<largeur>x<hauteur> agrandit le plateau (10000x10000...)
+    static void boardSize(size_t& width, size_t& height)
+    {
+        const char *value = std::getenv("ARCADE_SNAKE_SIZE");
+        size_t w = 0;
+        size_t h = 0;
+        if (value && std::sscanf(value, "%zux%zu", &w, &h) == 2 && w >= 10 && h >= 10 && w * h < (size_t {1} << 32)) {
+            width = w;
+            height = h;
+        }
+    }
+
     Snake::Snake()
         : IGame()
     {
@@ -31,6 +44,7 @@ namespace Arcade {
         
         mapWidth = DEFAULT_WIDTH;
         mapHeight = DEFAULT_HEIGHT;
+        boardSize(mapWidth, mapHeight);
         
         initMap();
 
@@ -40,16 +54,20 @@ namespace Arcade {
         size_t startX = mapWidth / 2;
         size_t startY = mapHeight / 2;
 
-        m_snake.clear();
+        m_snake.reset(mapWidth, mapHeight);
+        m_free.reset(mapWidth, mapHeight);
+        m_dirty.clear();
 
         for (size_t i = 0; i < INITIAL_SNAKE_SIZE; ++i) {
-            m_snake.push_back({startX - i, startY});
+            m_snake.pushTail({startX - i, startY});
+            m_free.remove(startX - i, startY);
+            m_dirty.push_back({startX - i, startY});
         }
         
 
         if (startX < INITIAL_SNAKE_SIZE + 2) startX = INITIAL_SNAKE_SIZE + 2;
         
-        m_lastUpdateTime = std::chrono::steady_clock::now();
+        m_lastUpdateTime = simTime;
         
         spawnFood();
         
@@ -62,7 +80,7 @@ namespace Arcade {
             map = std::make_unique<GameMap>(level, mapWidth, mapHeight);
         }
         
-        map->reset();
+        map->reshape(mapWidth, mapHeight);
         
         for (size_t x = 0; x < mapWidth; x++) {
             Cell* topCell = map->getCell(x, 0);
@@ -77,6 +95,14 @@ namespace Arcade {
             if (leftCell) leftCell->entity = EntityType::WALL;
             if (rightCell) rightCell->entity = EntityType::WALL;
         }
+
+        // Plateau vidé : une partie en cours (préchargement après reset())
+        // repeint son corps et sa nourriture au prochain updateMap()
+        if (!m_snake.empty()) {
+            for (const SnakePart segment : m_snake)
+                m_dirty.push_back(segment);
+            m_dirty.push_back(m_food);
+        }
     }
 
     void Snake::update(Input userInput)
@@ -113,7 +139,7 @@ namespace Arcade {
                 break;
         }
         
-        auto currentTime = std::chrono::steady_clock::now();
+        auto currentTime = simTime;
         auto elapsedTime = std::chrono::duration_cast<std::chrono::milliseconds>(
             currentTime - m_lastUpdateTime).count();
         
@@ -128,9 +154,10 @@ namespace Arcade {
 
     void Snake::moveSnake()
     {
+        TraceZone zone("Snake::moveSnake");
         m_direction = m_nextDirection;
         
-        SnakePart head = m_snake.front();
+        SnakePart head = m_snake.head();
         
         SnakePart newHead = head;
         
@@ -158,12 +185,11 @@ namespace Arcade {
             case Input::BACK:
             case Input::RESTART:
             case Input::ENTER:
+            case Input::PROFILER:
                 break;
         }
 
-        Cell* newHeadCell = map->getCell(newHead.x, newHead.y);
-        
-        if (newHeadCell && newHeadCell->entity == EntityType::WALL) {
+        if (map->getEntity(newHead.x, newHead.y) == EntityType::WALL) {
             map->decrementLife();
             if (map->getLives() <= 0) {
                 gameOver = true;
@@ -174,17 +200,7 @@ namespace Arcade {
             }
         }
         
-        bool collidesWithBody = false;
-        auto it = std::next(m_snake.begin());
-
-        for (; it != m_snake.end(); ++it) {
-            if (newHead.x == it->x && newHead.y == it->y) {
-                collidesWithBody = true;
-                break;
-            }
-        }
-
-        if (collidesWithBody) {
+        if (checkCollision(newHead.x, newHead.y)) {
             map->decrementLife();
             if (map->getLives() <= 0) {
                 gameOver = true;
@@ -195,7 +211,9 @@ namespace Arcade {
             }
         }
         
-        m_snake.push_front(newHead);
+        m_snake.pushHead(newHead);
+        m_free.remove(newHead.x, newHead.y);
+        m_dirty.push_back(newHead);
         
         if (newHead.x == m_food.x && newHead.y == m_food.y) {
             score += 10;
@@ -209,19 +227,27 @@ namespace Arcade {
                 }
             }
         } else {
-            m_snake.pop_back();
+            release(m_snake.tail());
+            m_dirty.push_back(m_snake.tail());
+            m_snake.popTail();
         }
     }
 
     void Snake::resetSnakePosition()
     {
-        m_snake.clear();
+        for (const SnakePart segment : m_snake) {
+            release(segment);
+            m_dirty.push_back(segment);
+        }
+        m_snake.reset(mapWidth, mapHeight);
         
         size_t startX = mapWidth / 2;
         size_t startY = mapHeight / 2;
         
         for (size_t i = 0; i < INITIAL_SNAKE_SIZE; ++i) {
-            m_snake.push_back({startX - i, startY});
+            m_snake.pushTail({startX - i, startY});
+            m_free.remove(startX - i, startY);
+            m_dirty.push_back({startX - i, startY});
         }
         
         m_direction = Arcade::Input::RIGHT;
@@ -230,54 +256,49 @@ namespace Arcade {
 
     void Snake::spawnFood()
     {
-        std::uniform_int_distribution<size_t> distX(1, mapWidth - 2);
-        std::uniform_int_distribution<size_t> distY(1, mapHeight - 2);
-        
-        do {
-            m_food.x = distX(m_rng);
-            m_food.y = distY(m_rng);
-            Cell* foodCell = map->getCell(m_food.x, m_food.y);
-            
-            if (foodCell && foodCell->entity == EntityType::WALL) continue;
-            if (checkCollision(m_food.x, m_food.y)) continue;
-            
-            break;
-        } while (true);
+        // Un seul tirage parmi les cases libres. Plus aucune : le serpent
+        // remplit le plateau, la partie est gagnée.
+        if (m_free.empty()) {
+            gameWon = true;
+            return;
+        }
+        const size_t cell = m_free.pick(m_rng);
+        m_food.x = cell % mapWidth;
+        m_food.y = cell / mapWidth;
+        m_free.remove(m_food.x, m_food.y);
+        m_dirty.push_back(m_food);
+    }
+
+    // Case quittée par le serpent. Après une vie perdue, le corps replacé
+    // peut recouvrir la nourriture : sa case reste prise.
+    void Snake::release(SnakePart segment)
+    {
+        if (segment.x != m_food.x || segment.y != m_food.y)
+            m_free.insert(segment.x, segment.y);
     }
 
     bool Snake::checkCollision(size_t x, size_t y) const
     {
-        auto it = std::next(m_snake.begin());
-        
-        return std::any_of(it, m_snake.end(), [x, y](const SnakePart& segment) {
-            return segment.x == x && segment.y == y; 
-        });
+        // Tout le corps sauf la tête, queue comprise : elle n'a pas encore
+        // quitté sa case quand la nouvelle tête y arrive
+        const SnakePart head = m_snake.head();
+        return m_snake.occupied(x, y) && (x != head.x || y != head.y);
     }
 
     void Snake::updateMap()
     {
-        for (size_t y = 1; y < mapHeight - 1; y++) {
-            for (size_t x = 1; x < mapWidth - 1; x++) {
-                Cell* cell = map->getCell(x, y);
-                if (cell) cell->entity = EntityType::EMPTY;
-            }
-        }
-        
-        Cell* foodCell = map->getCell(m_food.x, m_food.y);
-        if (foodCell) foodCell->entity = EntityType::BONUS;
-        
-        bool isHead = true;
-        for (const auto& segment : m_snake) {
-            Cell* snakeCell = map->getCell(segment.x, segment.y);
-            if (snakeCell) {
-                if (isHead) {
-                    snakeCell->entity = EntityType::PLAYER;
-                    isHead = false;
-                } else {
-                    snakeCell->entity = EntityType::PLAYER;
-                }
-            }
+        // Seules les cases touchées depuis le dernier tour sont réécrites :
+        // nouvelle tête, ancienne queue, nourriture (tout le corps après une
+        // vie perdue ou un redémarrage, le plateau venant d'être vidé)
+        for (const SnakePart cell : m_dirty) {
+            EntityType type = EntityType::EMPTY;
+            if (m_snake.occupied(cell.x, cell.y))
+                type = EntityType::PLAYER;
+            else if (cell.x == m_food.x && cell.y == m_food.y)
+                type = EntityType::BONUS;
+            map->setCell(cell.x, cell.y, type);
         }
+        m_dirty.clear();
         
         map->setScore(score);
         map->setLevel(level);
@@ -287,10 +308,10 @@ namespace Arcade {
             map->setMessage("Game Over! Press R to restart");
         } else if (gameWon) {
             map->setMessage("Victory! Press R to restart");
-            map->setFlag("VICTORY", true);
+            map->setFlag(MapFlag::VICTORY, true);
         } else {
             map->setMessage("");
-            map->setFlag("VICTORY", false);
+            map->setFlag(MapFlag::VICTORY, false);
         }
     }
 
@@ -316,10 +337,24 @@ namespace Arcade {
     {
         return name;
     }
+
+    void Snake::setSeed(unsigned int seed)
+    {
+        m_rng.seed(seed);
+        reset();
+    }
 }
 
 extern "C" {
     Arcade::IGame* createGame() {
         return new Arcade::Snake();
     }
+
+    unsigned int getApiVersion() {
+        return Arcade::API_VERSION;
+    }
+
+    void setTraceSink(Arcade::ITraceSink *sink) {
+        Arcade::trace::setSink(sink);
+    }
 }
\ No newline at end of file
@@ -2,24 +2,23 @@
 #define SNAKE_HPP
 
 #include "IGame.hpp"
-#include <deque>
+#include "freeCells.hpp"
+#include "snakeBody.hpp"
 #include <random>
 #include <chrono>
+#include <vector>
 
 namespace Arcade {
 
-    struct SnakePart {
-        size_t x;
-        size_t y;
-    };
-
     class Snake : public IGame {
         private:
             static constexpr size_t DEFAULT_WIDTH = 20;
             static constexpr size_t DEFAULT_HEIGHT = 20;
             static constexpr size_t INITIAL_SNAKE_SIZE = 4;
             static constexpr size_t INITIAL_SPEED = 200;
-            std::deque<SnakePart> m_snake;
+            SnakeBody m_snake;
+            FreeCells m_free;
+            std::vector<SnakePart> m_dirty;
             Input m_direction;
             Input m_nextDirection;
 
@@ -32,6 +31,7 @@ namespace Arcade {
 
             void moveSnake();
             void spawnFood();
+            void release(SnakePart segment);
             bool checkCollision(size_t x, size_t y) const;
             void updateMap();
             void resetSnakePosition();
@@ -47,6 +47,7 @@ namespace Arcade {
             bool isGameOver() const override;
             int getScore() const override;
             std::string getName() const override;
+            void setSeed(unsigned int seed) override;
         };
 
 }
@@ -0,0 +1,312 @@
+/*
+**  _                                              _      ___    ___
+** | |                                            | |    |__ \  / _ \
+** | |_Created _       _ __   _ __    ___    __ _ | |__     ) || (_) |
+** | '_ \ | | | |     | '_ \ | '_ \  / _ \  / _` || '_ \   / /  \__, |
+** | |_) || |_| |     | | | || | | || (_) || (_| || | | | / /_    / /
+** |_.__/  \__, |     |_| |_||_| |_| \___/  \__,_||_| |_||____|  /_/
+**          __/ |     on 18/10/26.
+**         |___/
+*/
+
+#ifndef SNAKEBATCH_HPP
+#define SNAKEBATCH_HPP
+#include <bit>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+#include "../../includes/my.hpp"
+
+namespace Arcade
+{
+    /*
+     * N parties de Snake indépendantes sur des plateaux de même taille, pour
+     * évaluer des bots en masse sans instancier de Snake (GameMap, corps,
+     * mt19937 par partie).
+     *
+     * Un step() avance toutes les parties d'un tour de moveSnake(), avec
+     * les mêmes règles : demi-tour refusé, mur ou corps (queue comprise)
+     * coûtent une vie et replacent le serpent au centre vers la droite, la
+     * nourriture rapporte 10 points et réapparaît uniformément sur une case
+     * libre, trois vies comme une GameMap neuve, plateau rempli = victoire.
+     * La cadence (niveau, intervalle entre tours) n'est pas simulée : un
+     * step() est un tour.
+     *
+     * Rangement en colonnes : têtes, directions, scores, vies, nourriture et
+     * graines sont des tableaux contigus indexés par partie ; chaque partie a
+     * sa tranche de la file circulaire des corps et du bitmap d'occupation.
+     * Les cases sont numérotées sur l'intérieur du plateau (sans les murs)
+     * et tiennent sur 16 bits. Les bits de bourrage du bitmap restent à 1 :
+     * les zéros sont exactement les cases libres.
+     *
+     * Une partie terminée (done) est relancée à la fin du même step().
+     */
+    class SnakeBatch {
+        public:
+            static constexpr size_t INITIAL_LENGTH = 4;
+            static constexpr uint8_t INITIAL_LIVES = 3;
+            static constexpr int32_t FOOD_SCORE = 10;
+
+            struct Position {
+                size_t x;
+                size_t y;
+            };
+
+        private:
+            size_t _count;
+            size_t _width;
+            size_t _height;
+            size_t _inner;
+            size_t _cells;
+            size_t _words;
+
+            std::vector<uint16_t> _headX;
+            std::vector<uint16_t> _headY;
+            std::vector<uint8_t> _direction;
+            std::vector<int32_t> _score;
+            std::vector<uint8_t> _lives;
+            std::vector<uint16_t> _food;
+            std::vector<uint64_t> _rng;
+            std::vector<uint32_t> _first;
+            std::vector<uint32_t> _length;
+            std::vector<uint16_t> _ring;
+            std::vector<uint64_t> _bits;
+
+            uint64_t *bitsOf(size_t game) { return _bits.data() + game * _words; }
+            const uint64_t *bitsOf(size_t game) const { return _bits.data() + game * _words; }
+            uint16_t *ringOf(size_t game) { return _ring.data() + game * _cells; }
+            const uint16_t *ringOf(size_t game) const { return _ring.data() + game * _cells; }
+
+            bool test(size_t game, size_t slot) const
+            {
+                return (bitsOf(game)[slot >> 6] >> (slot & 63)) & 1;
+            }
+
+            // splitmix64 : 8 octets d'état par partie
+            uint64_t next(size_t game)
+            {
+                uint64_t z = (_rng[game] += 0x9e3779b97f4a7c15ULL);
+                z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+                z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+                return z ^ (z >> 31);
+            }
+
+            // Entier uniforme dans [0, bound), sans biais (Lemire)
+            uint32_t below(size_t game, uint32_t bound)
+            {
+                uint64_t product = (next(game) >> 32) * bound;
+                if (static_cast<uint32_t>(product) < bound) {
+                    const uint32_t threshold = -bound % bound;
+                    while (static_cast<uint32_t>(product) < threshold)
+                        product = (next(game) >> 32) * bound;
+                }
+                return static_cast<uint32_t>(product >> 32);
+            }
+
+            void pushHead(size_t game, size_t x, size_t y)
+            {
+                uint32_t& first = _first[game];
+                first = first == 0 ? static_cast<uint32_t>(_cells - 1) : first - 1;
+                const size_t slot = y * _inner + x;
+                ringOf(game)[first] = static_cast<uint16_t>(slot);
+                bitsOf(game)[slot >> 6] |= uint64_t {1} << (slot & 63);
+                _headX[game] = static_cast<uint16_t>(x);
+                _headY[game] = static_cast<uint16_t>(y);
+                _length[game]++;
+            }
+
+            void popTail(size_t game)
+            {
+                size_t index = _first[game] + _length[game] - 1;
+                if (index >= _cells)
+                    index -= _cells;
+                const size_t slot = ringOf(game)[index];
+                bitsOf(game)[slot >> 6] &= ~(uint64_t {1} << (slot & 63));
+                _length[game]--;
+            }
+
+            // Serpent de départ au centre, tourné vers la droite (resetSnakePosition)
+            void placeSnake(size_t game)
+            {
+                while (_length[game] > 0)
+                    popTail(game);
+                _first[game] = 0;
+                const size_t x = _width / 2 - 1;
+                const size_t y = _height / 2 - 1;
+                for (size_t i = INITIAL_LENGTH; i-- > 0;)
+                    pushHead(game, x - i, y);
+                _direction[game] = static_cast<uint8_t>(Input::RIGHT);
+            }
+
+            // r-ième case libre, tirée uniformément ; false si le plateau est plein
+            bool spawnFood(size_t game)
+            {
+                const size_t free = _cells - _length[game];
+                if (free == 0)
+                    return false;
+                uint32_t rank = below(game, static_cast<uint32_t>(free));
+                const uint64_t *bits = bitsOf(game);
+                for (size_t word = 0; word < _words; ++word) {
+                    uint64_t zeros = ~bits[word];
+                    const uint32_t count = static_cast<uint32_t>(std::popcount(zeros));
+                    if (rank >= count) {
+                        rank -= count;
+                        continue;
+                    }
+                    for (; rank > 0; --rank)
+                        zeros &= zeros - 1;
+                    _food[game] = static_cast<uint16_t>(word * 64 + static_cast<size_t>(std::countr_zero(zeros)));
+                    return true;
+                }
+                return false;
+            }
+
+        public:
+            SnakeBatch(size_t count, size_t width = 20, size_t height = 20, uint64_t seed = 0)
+                : _count(count), _width(width), _height(height)
+            {
+                if (width < INITIAL_LENGTH * 2 + 2 || height < 3)
+                    throw std::runtime_error("SnakeBatch board too small");
+                _inner = width - 2;
+                _cells = _inner * (height - 2);
+                if (_cells > size_t {UINT16_MAX} + 1)
+                    throw std::runtime_error("SnakeBatch board too large");
+                _words = (_cells + 63) / 64;
+
+                _headX.resize(count);
+                _headY.resize(count);
+                _direction.resize(count);
+                _score.resize(count);
+                _lives.resize(count);
+                _food.resize(count);
+                _rng.resize(count);
+                _first.resize(count);
+                _length.resize(count);
+                _ring.resize(count * _cells);
+                _bits.resize(count * _words);
+                for (size_t game = 0; game < count; ++game) {
+                    _rng[game] = seed + game * 0xd1b54a32d192ed03ULL;
+                    reset(game);
+                }
+            }
+
+            // Nouvelle partie : plateau vide, trois vies, nourriture tirée
+            void reset(size_t game)
+            {
+                uint64_t *bits = bitsOf(game);
+                for (size_t word = 0; word < _words; ++word)
+                    bits[word] = 0;
+                if (_cells % 64 != 0)
+                    bits[_words - 1] = ~uint64_t {0} << (_cells % 64);
+                _length[game] = 0;
+                placeSnake(game);
+                _score[game] = 0;
+                _lives[game] = INITIAL_LIVES;
+                spawnFood(game);
+            }
+
+            /*
+             * Un tour pour chaque partie : inputs[i] est l'entrée de la partie
+             * i (les entrées autres que les directions sont ignorées),
+             * rewards[i] les points gagnés et done[i] vaut 1 si la partie
+             * s'est terminée (perdue ou gagnée) ; elle est alors relancée.
+             */
+            void step(const Input *inputs, int32_t *rewards, uint8_t *done)
+            {
+                for (size_t game = 0; game < _count; ++game) {
+                    const auto current = static_cast<Input>(_direction[game]);
+                    Input direction = current;
+                    switch (inputs[game]) {
+                        case Input::UP:
+                            if (current != Input::DOWN)
+                                direction = Input::UP;
+                            break;
+                        case Input::DOWN:
+                            if (current != Input::UP)
+                                direction = Input::DOWN;
+                            break;
+                        case Input::LEFT:
+                            if (current != Input::RIGHT)
+                                direction = Input::LEFT;
+                            break;
+                        case Input::RIGHT:
+                            if (current != Input::LEFT)
+                                direction = Input::RIGHT;
+                            break;
+                        default:
+                            break;
+                    }
+                    _direction[game] = static_cast<uint8_t>(direction);
+
+                    // Coordonnées intérieures : un mur donne x ou y hors de
+                    // [0, intérieur), y compris par débordement vers le haut
+                    size_t x = _headX[game];
+                    size_t y = _headY[game];
+                    if (direction == Input::UP)
+                        y--;
+                    else if (direction == Input::DOWN)
+                        y++;
+                    else if (direction == Input::LEFT)
+                        x--;
+                    else
+                        x++;
+
+                    rewards[game] = 0;
+                    done[game] = 0;
+                    if (x >= _inner || y >= _height - 2 || test(game, y * _inner + x)) {
+                        if (--_lives[game] == 0) {
+                            done[game] = 1;
+                            reset(game);
+                        } else {
+                            placeSnake(game);
+                        }
+                        continue;
+                    }
+                    pushHead(game, x, y);
+                    if (y * _inner + x != _food[game]) {
+                        popTail(game);
+                        continue;
+                    }
+                    _score[game] += FOOD_SCORE;
+                    rewards[game] = FOOD_SCORE;
+                    if (!spawnFood(game)) {
+                        done[game] = 1;
+                        reset(game);
+                    }
+                }
+            }
+
+            size_t size() const { return _count; }
+            size_t width() const { return _width; }
+            size_t height() const { return _height; }
+
+            // Positions en coordonnées du plateau, murs compris, comme Snake
+            Position head(size_t game) const { return {_headX[game] + size_t {1}, _headY[game] + size_t {1}}; }
+            Position food(size_t game) const { return {_food[game] % _inner + 1, _food[game] / _inner + 1}; }
+
+            // k-ième case du corps, tête à 0
+            Position segment(size_t game, size_t k) const
+            {
+                size_t index = _first[game] + k;
+                if (index >= _cells)
+                    index -= _cells;
+                const size_t slot = ringOf(game)[index];
+                return {slot % _inner + 1, slot / _inner + 1};
+            }
+
+            bool occupied(size_t game, size_t x, size_t y) const
+            {
+                if (x == 0 || y == 0 || x > _inner || y > _height - 2)
+                    return false;
+                return test(game, (y - 1) * _inner + (x - 1));
+            }
+
+            size_t length(size_t game) const { return _length[game]; }
+            Input direction(size_t game) const { return static_cast<Input>(_direction[game]); }
+            int32_t score(size_t game) const { return _score[game]; }
+            uint8_t lives(size_t game) const { return _lives[game]; }
+    };
+}
+
+#endif //SNAKEBATCH_HPP
@@ -0,0 +1,169 @@
+/*
+**  _                                              _      ___    ___
+** | |                                            | |    |__ \  / _ \
+** | |_Created _       _ __   _ __    ___    __ _ | |__     ) || (_) |
+** | '_ \ | | | |     | '_ \ | '_ \  / _ \  / _` || '_ \   / /  \__, |
+** | |_) || |_| |     | | | || | | || (_) || (_| || | | | / /_    / /
+** |_.__/  \__, |     |_| |_||_| |_| \___/  \__,_||_| |_||____|  /_/
+**          __/ |     on 18/10/26.
+**         |___/
+*/
+
+#ifndef SNAKEBODY_HPP
+#define SNAKEBODY_HPP
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+#include "../../includes/gameMap.hpp"
+
+namespace Arcade
+{
+    struct SnakePart {
+        size_t x;
+        size_t y;
+    };
+
+    /*
+     * Corps d'un serpent : file circulaire de cases, tête à l'indice 0, et
+     * bitmap d'occupation du plateau tenu à jour à la tête et à la queue.
+     * occupied() répond en temps constant quelle que soit la longueur.
+     *
+     * La file est un tableau circulaire dont la capacité (puissance de deux)
+     * ne double que lorsqu'il est plein. Le bitmap est découpé en tuiles de CHUNK_SIZE x
+     * CHUNK_SIZE cases allouées au premier passage, comme la grille de
+     * GameMap : sur un plateau de 10000x10000, seules les tuiles traversées
+     * coûtent de la mémoire.
+     *
+     * Les cases du corps sont distinctes (le jeu perd une vie avant de
+     * rentrer dans son propre corps) : un bit par case suffit.
+     */
+    class SnakeBody {
+        private:
+            using Tile = std::array<uint64_t, CHUNK_CELLS / 64>;
+
+            struct Slot {
+                uint32_t x;
+                uint32_t y;
+            };
+
+            std::vector<Slot> _ring = std::vector<Slot>(16);
+            size_t _first = 0;
+            size_t _count = 0;
+            size_t _width = 0;
+            size_t _height = 0;
+            size_t _across = 0;
+            std::vector<std::unique_ptr<Tile>> _tiles;
+
+            size_t slotOf(size_t i) const { return (_first + i) & (_ring.size() - 1); }
+            size_t tileOf(size_t x, size_t y) const { return (y >> CHUNK_SHIFT) * _across + (x >> CHUNK_SHIFT); }
+            static size_t bitOf(size_t x, size_t y) { return ((y & (CHUNK_SIZE - 1)) << CHUNK_SHIFT) | (x & (CHUNK_SIZE - 1)); }
+
+            void mark(SnakePart part, bool value)
+            {
+                std::unique_ptr<Tile>& tile = _tiles[tileOf(part.x, part.y)];
+                if (!tile)
+                    tile = std::make_unique<Tile>();
+                const size_t bit = bitOf(part.x, part.y);
+                if (value)
+                    (*tile)[bit >> 6] |= uint64_t {1} << (bit & 63);
+                else
+                    (*tile)[bit >> 6] &= ~(uint64_t {1} << (bit & 63));
+            }
+
+            void grow()
+            {
+                std::vector<Slot> ring(_ring.size() * 2);
+                for (size_t i = 0; i < _count; ++i)
+                    ring[i] = _ring[slotOf(i)];
+                _ring = std::move(ring);
+                _first = 0;
+            }
+
+        public:
+            class iterator {
+                private:
+                    const SnakeBody *_body;
+                    size_t _index;
+
+                public:
+                    iterator(const SnakeBody *body, size_t index) : _body(body), _index(index) {}
+                    SnakePart operator*() const { return (*_body)[_index]; }
+                    iterator& operator++() { ++_index; return *this; }
+                    bool operator==(const iterator& other) const { return _index == other._index; }
+            };
+
+            // Vide le corps pour un plateau width x height. Sur un plateau de
+            // même taille, seules les cases encore occupées sont effacées.
+            void reset(size_t width, size_t height)
+            {
+                if (width > UINT32_MAX || height > UINT32_MAX)
+                    throw std::runtime_error("Snake board too large");
+                if (width != _width || height != _height) {
+                    _width = width;
+                    _height = height;
+                    _across = (width + CHUNK_SIZE - 1) >> CHUNK_SHIFT;
+                    _tiles.clear();
+                    _tiles.resize(_across * ((height + CHUNK_SIZE - 1) >> CHUNK_SHIFT));
+                } else {
+                    for (size_t i = 0; i < _count; ++i)
+                        mark((*this)[i], false);
+                }
+                _first = 0;
+                _count = 0;
+            }
+
+            size_t size() const { return _count; }
+            bool empty() const { return _count == 0; }
+
+            SnakePart operator[](size_t i) const
+            {
+                const Slot& slot = _ring[slotOf(i)];
+                return {slot.x, slot.y};
+            }
+
+            SnakePart head() const { return (*this)[0]; }
+            SnakePart tail() const { return (*this)[_count - 1]; }
+
+            iterator begin() const { return {this, 0}; }
+            iterator end() const { return {this, _count}; }
+
+            bool occupied(size_t x, size_t y) const
+            {
+                if (x >= _width || y >= _height)
+                    return false;
+                const Tile *tile = _tiles[tileOf(x, y)].get();
+                const size_t bit = bitOf(x, y);
+                return tile && (((*tile)[bit >> 6] >> (bit & 63)) & 1);
+            }
+
+            void pushHead(SnakePart part)
+            {
+                if (_count == _ring.size())
+                    grow();
+                _first = (_first + _ring.size() - 1) & (_ring.size() - 1);
+                _ring[_first] = {static_cast<uint32_t>(part.x), static_cast<uint32_t>(part.y)};
+                _count++;
+                mark(part, true);
+            }
+
+            void pushTail(SnakePart part)
+            {
+                if (_count == _ring.size())
+                    grow();
+                _ring[slotOf(_count)] = {static_cast<uint32_t>(part.x), static_cast<uint32_t>(part.y)};
+                _count++;
+                mark(part, true);
+            }
+
+            void popTail()
+            {
+                mark(tail(), false);
+                _count--;
+            }
+    };
+}
+
+#endif //SNAKEBODY_HPP
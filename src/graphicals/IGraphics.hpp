@@ -12,20 +12,40 @@
 #ifndef IGRAPHICS_HPP
 #define IGRAPHICS_HPP
 
+#include <vector>
+
 #include "../../includes/gameMap.hpp"
 #include  "../../includes/my.hpp"
+#include "../../includes/trace.hpp"
 
 namespace Arcade {
 
 class IGraphics {
 protected:
     std::string name;
+    std::vector<std::string> overlay;
 public:
     virtual ~IGraphics() = default;
     virtual Arcade::Input getInput() = 0;
-    virtual void draw(GameMap map) = 0;
+    // La carte est empruntée le temps de l'appel, jamais copiée
+    virtual void draw(const GameMap& map) = 0;
     virtual std::string getName() = 0;
 
+    // Relève toutes les entrées en attente, horodatées, sans en perdre.
+    // Par défaut getInput() est rappelé jusqu'à ce qu'il ne renvoie plus rien.
+    virtual void pollInputs(std::vector<Arcade::InputEvent>& events)
+    {
+        for (auto input = getInput(); input != Arcade::Input::NONE; input = getInput())
+            events.push_back({input, std::chrono::steady_clock::now()});
+    }
+
+    // Lignes de texte (profiler) à afficher par-dessus la prochaine image ;
+    // une liste vide retire l'overlay.
+    virtual void setOverlay(const std::vector<std::string>& lines)
+    {
+        overlay = lines;
+    }
+
 };
 
 } // Arcade
@@ -16,7 +16,6 @@ namespace Arcade {
         keypad(stdscr, TRUE);
         curs_set(0);
         nodelay(stdscr, TRUE);
-        timeout(100);
         m_window = newwin(LINES, COLS, 0, 0);
         box(m_window, 0, 0);
         wrefresh(m_window);
@@ -49,53 +48,62 @@ namespace Arcade {
         return name;
     }
 
+    Input NCurseGraphics::translateKey(int ch)
+    {
+        switch (ch) {
+            case KEY_UP:
+            case 'z':
+            case 'w':
+                return Input::UP;
+            case KEY_DOWN:
+            case 's':
+                return Input::DOWN;
+            case KEY_LEFT:
+            case 'q':
+            case 'a':
+                return Input::LEFT;
+            case KEY_RIGHT:
+            case 'd':
+                return Input::RIGHT;
+            case 'g':
+                return Input::SWITCH_GAME;
+            case 'l':
+                return Input::SWITCH_LIB;
+            case 'r':
+                return Input::RESTART;
+            case 'm':
+                return Input::MENU;
+            case KEY_F(3):
+                return Input::PROFILER;
+            case 27: // ESC
+                m_isRunning = false;
+                return Input::EXIT;
+            default:
+                return Input::NONE;
+        }
+    }
+
     Input NCurseGraphics::getInput()
     {
         m_lastInput = Input::NONE;
         
         int ch = getch();
         if (ch != ERR) {
-            switch (ch) {
-                case KEY_UP:
-                case 'z':
-                case 'w':
-                    m_lastInput = Input::UP;
-                    break;
-                case KEY_DOWN:
-                case 's':
-                    m_lastInput = Input::DOWN;
-                    break;
-                case KEY_LEFT:
-                case 'q':
-                case 'a':
-                    m_lastInput = Input::LEFT;
-                    break;
-                case KEY_RIGHT:
-                case 'd':
-                    m_lastInput = Input::RIGHT;
-                    break;
-                case 'g':
-                    m_lastInput = Input::SWITCH_GAME;
-                    break;
-                case 'l':
-                    m_lastInput = Input::SWITCH_LIB;
-                    break;
-                case 'r':
-                    m_lastInput = Input::RESTART;
-                    break;
-                case 'm':
-                    m_lastInput = Input::MENU;
-                    break;
-                case 27: // ESC
-                    m_lastInput = Input::EXIT;
-                    m_isRunning = false;
-                    break;
-            }
+            m_lastInput = translateKey(ch);
         }
         
         return m_lastInput;
     }
 
+    void NCurseGraphics::pollInputs(std::vector<InputEvent>& events)
+    {
+        for (int ch = getch(); ch != ERR; ch = getch()) {
+            const Input input = translateKey(ch);
+            if (input != Input::NONE)
+                events.push_back({input, std::chrono::steady_clock::now()});
+        }
+    }
+
     void NCurseGraphics::renderCell(int y, int x, EntityType type)
     {
         short colorPair = 6;
@@ -142,16 +150,29 @@ namespace Arcade {
         wattroff(m_window, COLOR_PAIR(colorPair));
     }
 
-    void NCurseGraphics::draw(GameMap map)
+    void NCurseGraphics::draw(const GameMap& map)
     {
-        wclear(m_window);
-        box(m_window, 0, 0);
-        auto& grid = map.getCell();
-        for (size_t y = 0; y < grid.size(); ++y) {
-            for (size_t x = 0; x < grid[y].size(); ++x) {
-                renderCell(y, x, grid[y][x].entity);
+        // Seules les cases modifiées depuis la dernière image sont réécrites ;
+        // un changement de carte, de statut ou d'overlay redessine tout.
+        const MapChanges changes = map.changesSince(m_cursor);
+        const auto grid = map.getCell();
+        if (changes.full || changes.status || overlay.size() != m_overlaySize) {
+            werase(m_window);
+            for (size_t y = 0; y < grid.size(); ++y) {
+                const auto row = grid[y];
+                for (size_t x = 0; x < row.size(); ++x) {
+                    renderCell(y, x, row[x].entity);
+                }
+            }
+        } else {
+            for (const uint32_t index : changes.cells) {
+                const size_t x = index % map.getWidth();
+                const size_t y = index / map.getWidth();
+                renderCell(y, x, map.getEntity(x, y));
             }
         }
+        m_overlaySize = overlay.size();
+        box(m_window, 0, 0);
         if (map.hasScore()) {
             mvwprintw(m_window, 0, 2, "Score: %ld", map.getScore());
         }
@@ -164,6 +185,12 @@ namespace Arcade {
             mvwprintw(m_window, grid.size() / 2, (COLS - 9) / 2, "GAME OVER");
             wattroff(m_window, A_BOLD);
         }
+        for (size_t i = 0; i < overlay.size(); ++i) {
+            const int column = COLS - static_cast<int>(overlay[i].size()) - 2;
+            wattron(m_window, A_REVERSE);
+            mvwprintw(m_window, static_cast<int>(i) + 1, column > 0 ? column : 1, "%s", overlay[i].c_str());
+            wattroff(m_window, A_REVERSE);
+        }
         wrefresh(m_window);
     }
 
@@ -178,6 +205,14 @@ extern "C" {
     Arcade::IGraphics* createGraphics() {
         return new Arcade::NCurseGraphics();
     }
+
+    unsigned int getApiVersion() {
+        return Arcade::API_VERSION;
+    }
+
+    void setTraceSink(Arcade::ITraceSink *sink) {
+        Arcade::trace::setSink(sink);
+    }
 }
 
 
@@ -15,20 +15,26 @@ namespace Arcade {
         Input m_lastInput;
         bool m_isRunning;
         std::string name;
+        ChangeCursor m_cursor;
+        size_t m_overlaySize = 0;
 
         void initColors();
+        Input translateKey(int ch);
         void renderCell(int y, int x, EntityType type);        
     public:
         NCurseGraphics();
         ~NCurseGraphics() override;
-        void draw(GameMap map) override;
+        void draw(const GameMap& map) override;
         Input getInput() override;
+        void pollInputs(std::vector<InputEvent>& events) override;
         std::string getName() override;
     };
 }
 
 extern "C" {
     Arcade::IGraphics* createGraphics();
+    unsigned int getApiVersion();
+    void setTraceSink(Arcade::ITraceSink *sink);
 }
 
 #endif
\ No newline at end of file
@@ -0,0 +1,207 @@
+#include "null.hpp"
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <sstream>
+
+namespace Arcade {
+
+    namespace {
+        constexpr uint64_t FNV_OFFSET = 0xcbf29ce484222325ULL;
+        constexpr uint64_t FNV_PRIME = 0x100000001b3ULL;
+
+        uint64_t mix(uint64_t hash, uint64_t value)
+        {
+            for (int i = 0; i < 8; ++i) {
+                hash ^= (value >> (i * 8)) & 0xff;
+                hash *= FNV_PRIME;
+            }
+            return hash;
+        }
+
+        size_t readSize(const char *name, size_t fallback)
+        {
+            const char *value = std::getenv(name);
+            if (!value || !*value)
+                return fallback;
+            try {
+                return std::stoul(value);
+            } catch (const std::exception&) {
+                return fallback;
+            }
+        }
+    }
+
+    NullGraphics::NullGraphics()
+    {
+        name = "Null";
+        m_sessionChecksum = FNV_OFFSET;
+        m_frameLimit = readSize("ARCADE_NULL_FRAMES", m_frameLimit);
+        if (const char *script = std::getenv("ARCADE_NULL_INPUT"))
+            loadScript(script);
+        if (const char *log = std::getenv("ARCADE_NULL_LOG"))
+            m_log.open(log);
+        if (const char *stream = std::getenv("ARCADE_NULL_STREAM")) {
+            m_streamFile.open(stream, std::ios::binary | std::ios::trunc);
+            if (!m_streamFile.is_open())
+                throw std::runtime_error(std::string("Impossible d'ouvrir le flux d'images: ") + stream);
+            m_stream = std::make_unique<MapStreamWriter>(m_streamFile);
+        }
+        m_start = clock::now();
+        m_lastFrame = m_start;
+    }
+
+    /*
+     * Une commande par ligne, '#' pour les commentaires :
+     *   <frame> <INPUT>            entrée envoyée à la frame donnée
+     *   random <graine> <période>  direction aléatoire toutes les <période> frames
+     */
+    void NullGraphics::loadScript(const std::string& path)
+    {
+        std::ifstream file(path);
+        if (!file.is_open())
+            throw std::runtime_error("Impossible d'ouvrir le script d'entrées: " + path);
+
+        std::string line;
+        while (std::getline(file, line)) {
+            std::istringstream words(line);
+            std::string first;
+            if (!(words >> first) || first[0] == '#')
+                continue;
+            if (first == "random") {
+                unsigned int seed = 0;
+                words >> seed >> m_randomPeriod;
+                m_rng.seed(seed);
+                m_randomInput = true;
+                if (m_randomPeriod == 0)
+                    m_randomPeriod = 1;
+                continue;
+            }
+            std::string input;
+            words >> input;
+            m_script.push_back({std::stoul(first), inputFromString(input)});
+        }
+    }
+
+    // Empreinte de chaque tuile, recalculée seulement pour celles écrites
+    // depuis l'image précédente, et combinées par xor : le coût suit ce qui
+    // bouge, pas la surface de la carte.
+    uint64_t NullGraphics::checksum(const GameMap& map, bool full, uint64_t since)
+    {
+        const auto& kernels = kernels::active();
+        const auto hashChunk = [this, &kernels](const MapChunk& chunk) {
+            // Les cases hors de la carte restent vides : la tuile entière est hachée
+            const uint64_t hash = kernels.checksum(bytesOf(*chunk.chunk), CHUNK_CELLS, mix(FNV_OFFSET, chunk.index));
+            m_gridHash ^= m_chunkHashes[chunk.index] ^ hash;
+            m_chunkHashes[chunk.index] = hash;
+        };
+        if (full || m_chunkHashes.size() != map.chunkCount()) {
+            m_chunkHashes.assign(map.chunkCount(), 0);
+            m_gridHash = 0;
+            map.forEachChunk(hashChunk);
+        } else {
+            map.forEachChunkChangedSince(since, hashChunk);
+        }
+
+        uint64_t hash = mix(FNV_OFFSET, m_gridHash);
+        hash = mix(hash, map.getScore());
+        hash = mix(hash, map.getLives());
+        hash = mix(hash, map.getLevel());
+        return mix(hash, map.isGameOver());
+    }
+
+    Input NullGraphics::nextInput()
+    {
+        if (m_frameLimit > 0 && m_frames >= m_frameLimit)
+            return Input::ESCAPE;
+        if (m_cursor < m_script.size() && m_script[m_cursor].frame <= m_frames)
+            return m_script[m_cursor++].input;
+        // Une seule entrée aléatoire par frame, même si l'on est interrogé plusieurs fois
+        if (m_randomInput && m_frames % m_randomPeriod == 0 && m_lastRandomFrame != m_frames) {
+            static constexpr Input directions[] = {Input::UP, Input::DOWN, Input::LEFT, Input::RIGHT};
+            m_lastRandomFrame = m_frames;
+            return directions[std::uniform_int_distribution<size_t>(0, 3)(m_rng)];
+        }
+        return Input::NONE;
+    }
+
+    Input NullGraphics::getInput()
+    {
+        return nextInput();
+    }
+
+    void NullGraphics::pollInputs(std::vector<InputEvent>& events)
+    {
+        for (auto input = nextInput(); input != Input::NONE; input = nextInput()) {
+            events.push_back({input, clock::now()});
+            if (input == Input::ESCAPE)
+                break;
+        }
+    }
+
+    void NullGraphics::draw(const GameMap& map)
+    {
+        const auto now = clock::now();
+        if (m_frames > 0) {
+            const auto elapsed = now - m_lastFrame;
+            m_minFrame = std::min(m_minFrame, elapsed);
+            m_maxFrame = std::max(m_maxFrame, elapsed);
+        }
+        m_lastFrame = now;
+
+        // Nombre de cases qu'un renderer incrémental aurait redessinées
+        const uint64_t since = m_changeCursor.revision;
+        const MapChanges changes = map.changesSince(m_changeCursor);
+        m_changedCells += changes.full ? map.getWidth() * map.getHeight() : changes.cells.size();
+
+        m_lastChecksum = checksum(map, changes.full, since);
+        m_sessionChecksum = mix(m_sessionChecksum, m_lastChecksum);
+        m_mapWidth = map.getWidth();
+        m_mapHeight = map.getHeight();
+        if (m_log.is_open())
+            m_log << m_frames << ' ' << std::hex << m_lastChecksum << std::dec << '\n';
+        if (m_stream)
+            m_stream->write(map);
+        m_frames++;
+    }
+
+    std::string NullGraphics::getName()
+    {
+        return name;
+    }
+
+    NullGraphics::~NullGraphics()
+    {
+        const double seconds = std::chrono::duration<double>(m_lastFrame - m_start).count();
+        const auto ms = [](clock::duration d) { return std::chrono::duration<double, std::milli>(d).count(); };
+
+        std::fprintf(stderr, "[null] %zu frames in %.3f s (%.1f frames/s)\n",
+            m_frames, seconds, seconds > 0 ? static_cast<double>(m_frames) / seconds : 0.0);
+        if (m_frames > 1)
+            std::fprintf(stderr, "[null] frame time min/avg/max: %.3f / %.3f / %.3f ms\n",
+                ms(m_minFrame), seconds * 1000.0 / static_cast<double>(m_frames - 1), ms(m_maxFrame));
+        if (m_frames > 0)
+            std::fprintf(stderr, "[null] cells changed per frame: %.2f of %zu\n",
+                static_cast<double>(m_changedCells) / static_cast<double>(m_frames), m_mapWidth * m_mapHeight);
+        if (m_stream && m_stream->frames() > 0)
+            std::fprintf(stderr, "[null] map stream: %zu bytes, %.1f bytes/frame (raw %zu)\n", m_stream->bytes(),
+                static_cast<double>(m_stream->bytes()) / static_cast<double>(m_stream->frames()), m_mapWidth * m_mapHeight);
+        std::fprintf(stderr, "[null] map %zux%zu, last checksum %016llx, session checksum %016llx\n",
+            m_mapWidth, m_mapHeight, static_cast<unsigned long long>(m_lastChecksum),
+            static_cast<unsigned long long>(m_sessionChecksum));
+    }
+}
+
+extern "C" {
+    Arcade::IGraphics* createGraphics() {
+        return new Arcade::NullGraphics();
+    }
+
+    unsigned int getApiVersion() {
+        return Arcade::API_VERSION;
+    }
+
+    void setTraceSink(Arcade::ITraceSink *sink) {
+        Arcade::trace::setSink(sink);
+    }
+}
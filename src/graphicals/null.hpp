@@ -0,0 +1,88 @@
+/*
+**  _                                              _      ___    ___
+** | |                                            | |    |__ \  / _ \
+** | |_Created _       _ __   _ __    ___    __ _ | |__     ) || (_) |
+** | '_ \ | | | |     | '_ \ | '_ \  / _ \  / _` || '_ \   / /  \__, |
+** | |_) || |_| |     | | | || | | || (_) || (_| || | | | / /_    / /
+** |_.__/  \__, |     |_| |_||_| |_| \___/  \__,_||_| |_||____|  /_/
+**          __/ |     on 18/10/26.
+**         |___/
+*/
+
+#ifndef NULL_GRAPHICS_HPP
+#define NULL_GRAPHICS_HPP
+
+#include "IGraphics.hpp"
+#include "../../includes/mapStream.hpp"
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace Arcade {
+
+    struct ScriptedInput {
+        size_t frame;
+        Input input;
+    };
+
+    /*
+     * Backend sans fenêtre pour les mesures de débit : il ne dessine rien,
+     * calcule une somme de contrôle de chaque image reçue et rejoue des
+     * entrées lues dans un script (ARCADE_NULL_INPUT). Les images peuvent
+     * aussi être enregistrées en flux compressé (ARCADE_NULL_STREAM).
+     */
+    class NullGraphics : public IGraphics {
+    private:
+        using clock = std::chrono::steady_clock;
+
+        std::vector<ScriptedInput> m_script;
+        size_t m_cursor = 0;
+        size_t m_frameLimit = 3600;
+
+        bool m_randomInput = false;
+        size_t m_randomPeriod = 1;
+        size_t m_lastRandomFrame = static_cast<size_t>(-1);
+        std::mt19937 m_rng;
+
+        size_t m_frames = 0;
+        uint64_t m_lastChecksum = 0;
+        uint64_t m_sessionChecksum = 0;
+        size_t m_mapWidth = 0;
+        size_t m_mapHeight = 0;
+        ChangeCursor m_changeCursor;
+        size_t m_changedCells = 0;
+        std::vector<uint64_t> m_chunkHashes;
+        uint64_t m_gridHash = 0;
+        clock::time_point m_start;
+        clock::time_point m_lastFrame;
+        clock::duration m_minFrame = clock::duration::max();
+        clock::duration m_maxFrame = clock::duration::zero();
+        std::ofstream m_log;
+        std::ofstream m_streamFile;
+        std::unique_ptr<MapStreamWriter> m_stream;
+
+        void loadScript(const std::string& path);
+        uint64_t checksum(const GameMap& map, bool full, uint64_t since);
+        Input nextInput();
+
+    public:
+        NullGraphics();
+        ~NullGraphics() override;
+        void draw(const GameMap& map) override;
+        Input getInput() override;
+        void pollInputs(std::vector<InputEvent>& events) override;
+        std::string getName() override;
+    };
+}
+
+extern "C" {
+    Arcade::IGraphics* createGraphics();
+    unsigned int getApiVersion();
+    void setTraceSink(Arcade::ITraceSink *sink);
+}
+
+#endif
@@ -13,4 +13,12 @@
 
 extern "C" Arcade::IGraphics* createGraphics() {
     return new Arcade::SDLGraphics();
+}
+
+extern "C" unsigned int getApiVersion() {
+    return Arcade::API_VERSION;
+}
+
+extern "C" void setTraceSink(Arcade::ITraceSink *sink) {
+    Arcade::trace::setSink(sink);
 }
\ No newline at end of file
@@ -30,6 +30,12 @@ namespace Arcade
         int cellSize = 32; // taille d'une cellule (pixels)
         TTF_Font *font = nullptr;
 
+        // Grille déjà dessinée, mise à jour case par case entre deux images
+        SDL_Texture *gridTexture = nullptr;
+        int gridWidth = 0;
+        int gridHeight = 0;
+        Arcade::ChangeCursor cursor;
+
         std::unordered_map<Arcade::EntityType, SDL_Color> colors;
         std::unordered_map<std::string, SDL_Texture*> imgTexture;
 
@@ -61,6 +67,7 @@ namespace Arcade
             name = "SDL2";
             SDL_Init(SDL_INIT_VIDEO);
             TTF_Init();
+            IMG_Init(IMG_INIT_PNG);
             font = TTF_OpenFont("./lib/sdl2_assets/fonts/arialbd.ttf", 24);
             window = SDL_CreateWindow("Arcade SDL2",
                                       SDL_WINDOWPOS_CENTERED,
@@ -87,33 +94,54 @@ namespace Arcade
             for (auto& pair : imgTexture)
                 SDL_DestroyTexture(pair.second);
             imgTexture.clear();
+            if (gridTexture)
+                SDL_DestroyTexture(gridTexture);
             SDL_DestroyRenderer(renderer);
             SDL_DestroyWindow(window);
             SDL_Quit();
         }
 
+        static Arcade::Input translateKey(SDL_Keycode key)
+        {
+            switch (key) {
+            case SDLK_UP: return Arcade::Input::UP;
+            case SDLK_DOWN: return Arcade::Input::DOWN;
+            case SDLK_LEFT: return Arcade::Input::LEFT;
+            case SDLK_RIGHT: return Arcade::Input::RIGHT;
+            case SDLK_ESCAPE: return Arcade::Input::ESCAPE;
+            case SDLK_l: return Arcade::Input::SWITCH_LIB;
+            case SDLK_g: return Arcade::Input::SWITCH_GAME;
+            case SDLK_F3: return Arcade::Input::PROFILER;
+            default: return Arcade::Input::NONE;
+            }
+        }
+
         Arcade::Input getInput() override
         {
             SDL_Event event;
             while (SDL_PollEvent(&event)) {
                 if (event.type == SDL_QUIT)
                     return Arcade::Input::ESCAPE;
-                if (event.type == SDL_KEYDOWN) {
-                    switch (event.key.keysym.sym) {
-                    case SDLK_UP: return Arcade::Input::UP;
-                    case SDLK_DOWN: return Arcade::Input::DOWN;
-                    case SDLK_LEFT: return Arcade::Input::LEFT;
-                    case SDLK_RIGHT: return Arcade::Input::RIGHT;
-                    case SDLK_ESCAPE: return Arcade::Input::ESCAPE;
-                    case SDLK_l: return Arcade::Input::SWITCH_LIB;
-                    case SDLK_g: return Arcade::Input::SWITCH_GAME;
-                    default: return Arcade::Input::NONE;
-                    }
-                }
+                if (event.type == SDL_KEYDOWN)
+                    return translateKey(event.key.keysym.sym);
             }
             return Arcade::Input::NONE;
         }
 
+        void pollInputs(std::vector<Arcade::InputEvent>& events) override
+        {
+            SDL_Event event;
+            while (SDL_PollEvent(&event)) {
+                auto input = Arcade::Input::NONE;
+                if (event.type == SDL_QUIT)
+                    input = Arcade::Input::ESCAPE;
+                else if (event.type == SDL_KEYDOWN)
+                    input = translateKey(event.key.keysym.sym);
+                if (input != Arcade::Input::NONE)
+                    events.push_back({input, std::chrono::steady_clock::now()});
+            }
+        }
+
         void draw_score(size_t score) const
         {
             if (!font) return;
@@ -129,6 +157,26 @@ namespace Arcade
             SDL_FreeSurface(texte);
         }
 
+        void draw_overlay() const
+        {
+            if (!font) return;
+
+            const SDL_Color white = { 255, 255, 255, 255 };
+            int y = 70;
+            for (const auto& line : overlay) {
+                SDL_Surface *texte = TTF_RenderText_Solid(font, line.c_str(), white);
+                if (!texte) continue;
+                SDL_Texture *texteTexture = SDL_CreateTextureFromSurface(renderer, texte);
+                const SDL_Rect texteRect = {20, y, texte->w, texte->h};
+                SDL_SetRenderDrawColor(renderer, 0, 0, 0, 255);
+                SDL_RenderFillRect(renderer, &texteRect);
+                SDL_RenderCopy(renderer, texteTexture, nullptr, &texteRect);
+                SDL_DestroyTexture(texteTexture);
+                y += texte->h;
+                SDL_FreeSurface(texte);
+            }
+        }
+
         void draw_lives(size_t lives)
         {
             const std::string imagePath = "./lib/sdl2_assets/img/heart.png";
@@ -142,43 +190,73 @@ namespace Arcade
             }
         }
 
-        void draw(Arcade::GameMap map) override
+        void draw(const Arcade::GameMap& map) override
         {
             int windowWidth, windowHeight;
             SDL_GetWindowSize(window, &windowWidth, &windowHeight);
-            const int offsetX = (windowWidth - static_cast<int>(map.getWidth()) * cellSize) / 2;
-            const int offsetY = (windowHeight - static_cast<int>(map.getHeight()) * cellSize) / 2;
+            const int width = static_cast<int>(map.getWidth()) * cellSize;
+            const int height = static_cast<int>(map.getHeight()) * cellSize;
+            const int offsetX = (windowWidth - width) / 2;
+            const int offsetY = (windowHeight - height) / 2;
+
+            updateGrid(map, width, height);
 
             SDL_SetRenderDrawColor(renderer, 0, 0, 0, 255);
             SDL_RenderClear(renderer);
 
             draw_score(map.getScore());
             draw_lives(map.getLives());
-            for (size_t y = 0; y <= map.getHeight(); ++y) {
-                for (size_t x = 0; x <= map.getWidth(); ++x) {
-                    const Arcade::Cell* cell = map.getCell(x, y);
-                    if (cell)
-                        drawCell(x, y, cell->entity, map, offsetX, offsetY);
-                }
-            }
+            const SDL_Rect gridRect = {offsetX, offsetY, width, height};
+            SDL_RenderCopy(renderer, gridTexture, nullptr, &gridRect);
+            draw_overlay();
             SDL_RenderPresent(renderer);
 //          std::cout << "map received" << std::endl;
         }
         std::string getName() override { return name; }
 
     private:
-        void drawCell(size_t x, size_t y, Arcade::EntityType type, Arcade::GameMap &map, int offsetX, int offsetY)
+        // Redessine dans gridTexture les cases modifiées depuis la dernière
+        // image, ou toute la grille si la carte a changé de taille ou de jeu.
+        void updateGrid(const Arcade::GameMap& map, int width, int height)
         {
-            IMG_Init(IMG_INIT_PNG);
+            bool full = false;
+            if (!gridTexture || width != gridWidth || height != gridHeight) {
+                if (gridTexture)
+                    SDL_DestroyTexture(gridTexture);
+                gridTexture = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_RGBA8888, SDL_TEXTUREACCESS_TARGET, width, height);
+                gridWidth = width;
+                gridHeight = height;
+                full = true;
+            }
+            const Arcade::MapChanges changes = map.changesSince(cursor);
+
+            SDL_SetRenderTarget(renderer, gridTexture);
+            if (full || changes.full) {
+                for (size_t y = 0; y < map.getHeight(); ++y)
+                    for (size_t x = 0; x < map.getWidth(); ++x)
+                        drawCell(x, y, map.getEntity(x, y), map, 0, 0);
+            } else {
+                for (const uint32_t index : changes.cells) {
+                    const size_t x = index % map.getWidth();
+                    const size_t y = index / map.getWidth();
+                    drawCell(x, y, map.getEntity(x, y), map, 0, 0);
+                }
+            }
+            SDL_SetRenderTarget(renderer, nullptr);
+        }
+
+        void drawCell(size_t x, size_t y, Arcade::EntityType type, const Arcade::GameMap &map, int offsetX, int offsetY)
+        {
+            const SDL_Rect rect = { static_cast<int>(offsetX + x * cellSize), static_cast<int>(offsetY + y * cellSize), cellSize, cellSize };
             const std::string imagePath = map.getEntityImagePath(type);
             SDL_Texture* image = getTexture(map.getImagePathsDirectory() + imagePath);
             if (image != nullptr) {
-                const SDL_Rect dest = { static_cast<int>(offsetX + x * cellSize), static_cast<int>(offsetY + y * cellSize), cellSize, cellSize };
-                SDL_RenderCopy(renderer, image, nullptr, &dest);
+                // La case garde l'image précédente : on l'efface avant de poser la nouvelle
+                SDL_SetRenderDrawColor(renderer, 0, 0, 0, 255);
+                SDL_RenderFillRect(renderer, &rect);
+                SDL_RenderCopy(renderer, image, nullptr, &rect);
                 return;
             }
-            SDL_DestroyTexture(image);
-            const SDL_Rect rect = { static_cast<int>(offsetX + x * cellSize), static_cast<int>(offsetY + y * cellSize), cellSize, cellSize };
             auto [r, g, b, a] = colors[type];
             SDL_SetRenderDrawColor(renderer, r, g, b, a);
             SDL_RenderFillRect(renderer, &rect);
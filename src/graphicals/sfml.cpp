@@ -97,7 +97,6 @@ namespace Arcade {
         settings.antialiasingLevel = 8;
         
         m_window.create(sf::VideoMode(1024, 768), "Made By Chrisnaud (JaceX10)", sf::Style::Close, settings);
-        m_window.setFramerateLimit(60);
         
         initColorThemes();
         
@@ -286,6 +285,41 @@ namespace Arcade {
         return name;
     }
 
+    Input SFMLGraphics::translateKey(sf::Keyboard::Key key)
+    {
+        switch (key) {
+            case sf::Keyboard::Up:
+            case sf::Keyboard::Z:
+            case sf::Keyboard::W:
+                return Input::UP;
+            case sf::Keyboard::Down:
+            case sf::Keyboard::S:
+                return Input::DOWN;
+            case sf::Keyboard::Left:
+            case sf::Keyboard::Q:
+            case sf::Keyboard::A:
+                return Input::LEFT;
+            case sf::Keyboard::Right:
+            case sf::Keyboard::D:
+                return Input::RIGHT;
+            case sf::Keyboard::G:
+                return Input::SWITCH_GAME;
+            case sf::Keyboard::L:
+                return Input::SWITCH_LIB;
+            case sf::Keyboard::R:
+                return Input::RESTART;
+            case sf::Keyboard::M:
+                return Input::MENU;
+            case sf::Keyboard::F3:
+                return Input::PROFILER;
+            case sf::Keyboard::T:
+                cycleTheme();
+                return Input::NONE;
+            default:
+                return Input::NONE;
+        }
+    }
+
     Input SFMLGraphics::getInput()
     {
         m_lastInput = Input::NONE;
@@ -298,52 +332,33 @@ namespace Arcade {
             }
             
             if (event.type == sf::Event::KeyPressed) {
-                switch (event.key.code) {
-                    case sf::Keyboard::Up:
-                    case sf::Keyboard::Z:
-                    case sf::Keyboard::W:
-                        m_lastInput = Input::UP;
-                        break;
-                    case sf::Keyboard::Down:
-                    case sf::Keyboard::S:
-                        m_lastInput = Input::DOWN;
-                        break;
-                    case sf::Keyboard::Left:
-                    case sf::Keyboard::Q:
-                    case sf::Keyboard::A:
-                        m_lastInput = Input::LEFT;
-                        break;
-                    case sf::Keyboard::Right:
-                    case sf::Keyboard::D:
-                        m_lastInput = Input::RIGHT;
-                        break;
-                    case sf::Keyboard::G:
-                        m_lastInput = Input::SWITCH_GAME;
-                        break;
-                    case sf::Keyboard::L:
-                        m_lastInput = Input::SWITCH_LIB;
-                        break;
-                    case sf::Keyboard::R:
-                        m_lastInput = Input::RESTART;
-                        break;
-                    case sf::Keyboard::M:
-                        m_lastInput = Input::MENU;
-                        break;
-                    case sf::Keyboard::T:
-                        m_currentTheme = (m_currentTheme + 1) % m_themes.size();
-                        m_colorMap = getActiveColorMap();
-                        generateBackground();
-                        break;
-                    default:
-                        break;
-                }
+                const Input input = translateKey(event.key.code);
+                if (input != Input::NONE)
+                    m_lastInput = input;
             }
         }
         
         return m_lastInput;
     }
 
-    void SFMLGraphics::draw(GameMap map)
+    void SFMLGraphics::pollInputs(std::vector<InputEvent>& events)
+    {
+        sf::Event event;
+        while (m_window.pollEvent(event)) {
+            if (event.type == sf::Event::Closed) {
+                m_window.close();
+                exit(0);
+            }
+            
+            if (event.type == sf::Event::KeyPressed) {
+                const Input input = translateKey(event.key.code);
+                if (input != Input::NONE)
+                    events.push_back({input, std::chrono::steady_clock::now()});
+            }
+        }
+    }
+
+    void SFMLGraphics::draw(const GameMap& map)
     {
         if (!m_window.isOpen()) {
             return;
@@ -355,7 +370,7 @@ namespace Arcade {
         m_window.clear(m_themes[m_currentTheme].background);
         m_window.draw(m_backgroundSprite);
         
-        auto& grid = map.getCell();
+        const auto grid = map.getCell();
         
         if (grid.empty() || grid[0].empty()) {
             displayErrorMessage("Empty grid data");
@@ -390,8 +405,9 @@ namespace Arcade {
         float rotationFactor = 45.0f * std::sin(m_animationTimer * 0.5f);
         
         for (size_t y = 0; y < gridHeight; ++y) {
+            const auto row = grid[y];
             for (size_t x = 0; x < gridWidth; ++x) {
-                Arcade::EntityType type = grid[y][x].entity;
+                Arcade::EntityType type = row[x].entity;
                 
                 if (type == Arcade::EntityType::EMPTY) {
                     continue;
@@ -422,6 +438,7 @@ namespace Arcade {
         m_visualEffects->draw(m_window);
         
         displayGameInfo(map);
+        displayOverlay();
         
         m_window.display();
     }
@@ -429,6 +446,7 @@ namespace Arcade {
     void SFMLGraphics::renderCell(Arcade::EntityType type, float x, float y, float size, 
         const sf::Color& color, float animFactor, float rotationFactor)
     {
+        TraceZone zone("SFMLGraphics::renderCell");
         float itemSize;
         sf::Color renderColor = color;
 
@@ -678,7 +696,7 @@ namespace Arcade {
             m_window.draw(themeIndicator);
         }
 
-        if (map.isGameOver() || map.hasFlag("VICTORY") || map.hasFlag("PAUSED")) {
+        if (map.isGameOver() || map.hasFlag(MapFlag::VICTORY) || map.hasFlag(MapFlag::PAUSED)) {
             sf::RectangleShape overlay;
             overlay.setSize(sf::Vector2f(1024, 768));
             overlay.setFillColor(sf::Color(0, 0, 0, 150));
@@ -697,7 +715,7 @@ namespace Arcade {
                     gameOverParticlesGenerated = true;
                 }
             } 
-            else if (map.hasFlag("VICTORY")) {
+            else if (map.hasFlag(MapFlag::VICTORY)) {
                 statusMessage = "VICTORY!\nScore: " + std::to_string(map.getScore()) + "\nPress R to restart";
                 statusColor = sf::Color(152, 195, 121);
                 
@@ -707,7 +725,7 @@ namespace Arcade {
                     victoryParticlesGenerated = true;
                 }
             } 
-            else if (map.hasFlag("PAUSED")) {
+            else if (map.hasFlag(MapFlag::PAUSED)) {
                 statusMessage = "PAUSED\nPress P to continue";
                 statusColor = sf::Color(229, 192, 123);
             }
@@ -782,6 +800,28 @@ namespace Arcade {
         m_window.draw(errorIcon);
     }
 
+    void SFMLGraphics::displayOverlay()
+    {
+        if (overlay.empty())
+            return;
+
+        sf::RectangleShape panel;
+        panel.setSize(sf::Vector2f(380, 22.0f * overlay.size() + 12));
+        panel.setPosition(10, 10);
+        panel.setFillColor(sf::Color(0, 0, 0, 180));
+        m_window.draw(panel);
+
+        sf::Text line;
+        line.setFont(m_font);
+        line.setCharacterSize(16);
+        line.setFillColor(m_themes[m_currentTheme].text);
+        for (size_t i = 0; i < overlay.size(); ++i) {
+            line.setString(overlay[i]);
+            line.setPosition(18, 16 + 22.0f * i);
+            m_window.draw(line);
+        }
+    }
+
     void SFMLGraphics::cycleTheme()
     {
         m_currentTheme = (m_currentTheme + 1) % m_themes.size();
@@ -801,4 +841,12 @@ extern "C" {
     Arcade::IGraphics* createGraphics() {
         return new Arcade::SFMLGraphics();
     }
+
+    unsigned int getApiVersion() {
+        return Arcade::API_VERSION;
+    }
+
+    void setTraceSink(Arcade::ITraceSink *sink) {
+        Arcade::trace::setSink(sink);
+    }
 }
\ No newline at end of file
@@ -64,11 +64,13 @@ namespace Arcade {
             void initRenderObjects();
             std::map<Arcade::EntityType, sf::Color> getActiveColorMap() const;
             void generateBackground();
+            Input translateKey(sf::Keyboard::Key key);
             
             void renderCell(Arcade::EntityType type, float x, float y, float size, 
                           const sf::Color& color, float animFactor, float rotationFactor);
             void displayGameInfo(const GameMap& map);
             void displayErrorMessage(const std::string& message);
+            void displayOverlay();
             
         public:
             std::string name;
@@ -77,7 +79,8 @@ namespace Arcade {
             
             std::string getName() override;
             Input getInput() override;
-            void draw(GameMap map) override;
+            void pollInputs(std::vector<InputEvent>& events) override;
+            void draw(const GameMap& map) override;
             void cycleTheme();
     };
 
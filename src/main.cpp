@@ -15,59 +15,27 @@
 #include <filesystem>
 
 #include "core/Core.hpp"
+#include "core/PluginScanner.hpp"
 
 std::unordered_map<int, std::string> GamePath;
 std::unordered_map<int, std::string> GraphPath;
-std::vector<std::filesystem::path> allLib;
+std::vector<PluginInfo> allLib;
 std::string path = "./lib";
 int CurrentGraphIndex = 0;
 int CurrentGameIndex = 0;
 
 void getAllLib()
 {
-    if (std::filesystem::exists(path) && std::filesystem::is_directory(path))
-        for (const auto& entry : std::filesystem::directory_iterator(path)) {
-            if (!std::filesystem::is_directory(entry.path())) {
-                allLib.push_back(entry.path());
-            }
-        }
-}
-
-bool ifGraphic(const std::string& libPath)
-{
-    void* _graphicsHandle = dlopen(libPath.c_str(), RTLD_LAZY);
-    if (!_graphicsHandle) throw std::runtime_error(dlerror());
-
-    const void *createGraphics = dlsym(_graphicsHandle, "createGraphics");
-    if (createGraphics) {
-        dlclose(_graphicsHandle);
-        return true;
-    }
-    dlclose(_graphicsHandle);
-    return false;
-}
-
-bool ifGame(const std::string& libPath)
-{
-    void* _gameHandle = dlopen(libPath.c_str(), RTLD_LAZY);
-    if (!_gameHandle) throw std::runtime_error(dlerror());
-
-    const void *createGame = dlsym(_gameHandle, "createGame");
-    if (createGame) {
-        dlclose(_gameHandle);
-        return true;
-    }
-    dlclose(_gameHandle);
-    return false;
+    allLib = PluginScanner(path).scan();
 }
 
 void getAllGame()
 {
     int i = 0;
     for (const auto& l : allLib) {
-        if (ifGame(l)) {
-            std::cout << l << std::endl;
-            GamePath[i] = l;
+        if (l.kind == PluginKind::GAME) {
+            std::cout << l.path << std::endl;
+            GamePath[i] = l.path;
             i++;
         }
     }
@@ -77,9 +45,9 @@ void getAllGraph()
 {
     int i = 0;
     for (const auto& l : allLib) {
-        if (ifGraphic(l)) {
-            GraphPath[i] = l;
-            std::cout << l << std::endl;
+        if (l.kind == PluginKind::GRAPHICS) {
+            GraphPath[i] = l.path;
+            std::cout << l.path << std::endl;
             i++;
         }
     }
@@ -124,6 +92,21 @@ std::string getNextGame()
     CurrentGameIndex++;
     return GamePath[static_cast<int>(CurrentGameIndex % GamePath.size())];
 }
+
+std::string peekNextGraphics()
+{
+    if (GraphPath.empty())
+        return "";
+    return GraphPath[static_cast<int>((CurrentGraphIndex + 1) % GraphPath.size())];
+}
+
+std::string peekNextGame()
+{
+    if (GamePath.empty())
+        return "";
+    return GamePath[static_cast<int>((CurrentGameIndex + 1) % GamePath.size())];
+}
+
 int main(int ac, char **av) {
     try {
         check_args(ac, av);
@@ -0,0 +1,196 @@
+/*
+**  _                                              _      ___    ___
+** | |                                            | |    |__ \  / _ \
+** | |_Created _       _ __   _ __    ___    __ _ | |__     ) || (_) |
+** | '_ \ | | | |     | '_ \ | '_ \  / _ \  / _` || '_ \   / /  \__, |
+** | |_) || |_| |     | | | || | | || (_) || (_| || | | | / /_    / /
+** |_.__/  \__, |     |_| |_||_| |_| \___/  \__,_||_| |_||____|  /_/
+**          __/ |     on 18/10/26.
+**         |___/
+*/
+
+#include <chrono>
+#include <cstdio>
+#include <functional>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "gameMap.hpp"
+#include "gridKernels.hpp"
+
+/*
+ * arcade_gridbench : compare les noyaux de gridKernels.hpp aux boucles
+ * imbriquées qu'ils remplacent, sur des plateaux de 20x20, 256x256 et
+ * 4096x4096. Construit par `make bench`, en -O2.
+ */
+namespace
+{
+    volatile uint64_t sink;
+
+    // Durée moyenne d'un appel, en répétant jusqu'à ~50 ms
+    double measure(const std::function<void()>& run)
+    {
+        using clock = std::chrono::steady_clock;
+        run();
+        size_t calls = 0;
+        const auto start = clock::now();
+        auto now = start;
+        do {
+            run();
+            calls++;
+            now = clock::now();
+        } while (now - start < std::chrono::milliseconds(50));
+        return std::chrono::duration<double, std::micro>(now - start).count() / static_cast<double>(calls);
+    }
+
+    struct Board {
+        size_t width;
+        size_t height;
+        std::vector<uint8_t> cells;
+        std::vector<uint8_t> next;
+    };
+
+    Board makeBoard(size_t side)
+    {
+        Board board {side, side, std::vector<uint8_t>(side * side), {}};
+        std::mt19937 rng(42);
+        for (auto& cell : board.cells)
+            cell = static_cast<uint8_t>(rng() % 4 == 0 ? rng() % Arcade::ENTITY_TYPE_COUNT : 0);
+        board.next = board.cells;
+        // Une case sur cent change d'une image à l'autre
+        for (size_t i = 0; i < board.next.size() / 100 + 1; ++i)
+            board.next[rng() % board.next.size()] ^= 1;
+        return board;
+    }
+
+    void row(const char *operation, size_t side, double loop, const std::vector<double>& kernels)
+    {
+        std::printf("%-10s %5zux%-5zu %12.2f", operation, side, side, loop);
+        for (const double time : kernels)
+            std::printf(" %12.2f (x%5.1f)", time, loop / time);
+        std::printf("\n");
+    }
+
+    void benchKernels(const Board& board, const std::vector<const Arcade::kernels::Table *>& tables)
+    {
+        const size_t side = board.width;
+        const size_t n = board.cells.size();
+        std::vector<uint8_t> scratch(n);
+        std::vector<uint32_t> dirty;
+        dirty.reserve(n);
+        std::vector<double> times;
+
+        const double fillLoop = measure([&] {
+            for (size_t y = 0; y < board.height; ++y)
+                for (size_t x = 0; x < board.width; ++x)
+                    if (scratch[y * board.width + x] != 3)
+                        scratch[y * board.width + x] = 3;
+            std::fill(scratch.begin(), scratch.end(), 0);
+        });
+        for (const auto *table : tables)
+            times.push_back(measure([&] {
+                table->fill(scratch.data(), n, 3);
+                std::fill(scratch.begin(), scratch.end(), 0);
+            }));
+        row("fill", side, fillLoop, times);
+
+        times.clear();
+        const double countLoop = measure([&] {
+            uint32_t counts[Arcade::ENTITY_TYPE_COUNT] = {};
+            for (size_t y = 0; y < board.height; ++y)
+                for (size_t x = 0; x < board.width; ++x)
+                    counts[board.cells[y * board.width + x]]++;
+            sink = counts[0];
+        });
+        for (const auto *table : tables)
+            times.push_back(measure([&] {
+                uint32_t counts[Arcade::ENTITY_TYPE_COUNT] = {};
+                table->countByType(board.cells.data(), n, counts);
+                sink = counts[0];
+            }));
+        row("count", side, countLoop, times);
+
+        times.clear();
+        const double diffLoop = measure([&] {
+            dirty.clear();
+            for (size_t y = 0; y < board.height; ++y)
+                for (size_t x = 0; x < board.width; ++x)
+                    if (board.cells[y * board.width + x] != board.next[y * board.width + x])
+                        dirty.push_back(static_cast<uint32_t>(y * board.width + x));
+            sink = dirty.size();
+        });
+        for (const auto *table : tables)
+            times.push_back(measure([&] {
+                dirty.clear();
+                table->diff(board.cells.data(), board.next.data(), n, 0, dirty);
+                sink = dirty.size();
+            }));
+        row("diff", side, diffLoop, times);
+
+        times.clear();
+        const double checksumLoop = measure([&] {
+            uint64_t hash = 0xcbf29ce484222325ULL;
+            for (size_t y = 0; y < board.height; ++y)
+                for (size_t x = 0; x < board.width; ++x)
+                    hash = (hash ^ board.cells[y * board.width + x]) * 0x100000001b3ULL;
+            sink = hash;
+        });
+        for (const auto *table : tables)
+            times.push_back(measure([&] { sink = table->checksum(board.cells.data(), n, 0); }));
+        row("checksum", side, checksumLoop, times);
+    }
+
+    // Effacement de l'intérieur, tel que Snake/Nibbler le faisaient case par case
+    void benchMap(size_t side)
+    {
+        Arcade::GameMap map(1, side, side);
+        map.fill(0, 0, side, side, Arcade::EntityType::WALL);
+        map.fill(1, 1, side - 2, side - 2, Arcade::EntityType::EMPTY);
+        map.setCell(side / 2, side / 2, Arcade::EntityType::PLAYER);
+        const double loop = measure([&] {
+            for (size_t y = 1; y < side - 1; ++y)
+                for (size_t x = 1; x < side - 1; ++x)
+                    if (map.getEntity(x, y) != Arcade::EntityType::EMPTY)
+                        map.setCell(x, y, Arcade::EntityType::EMPTY);
+            map.setCell(side / 2, side / 2, Arcade::EntityType::PLAYER);
+        });
+        const double kernel = measure([&] {
+            map.fill(1, 1, side - 2, side - 2, Arcade::EntityType::EMPTY);
+            map.setCell(side / 2, side / 2, Arcade::EntityType::PLAYER);
+        });
+        row("map clear", side, loop, {kernel});
+
+        const Arcade::GameMap before = map;
+        map.setCell(1, 1, Arcade::EntityType::BONUS);
+        const double compareLoop = measure([&] {
+            size_t changed = 0;
+            for (size_t y = 0; y < side; ++y)
+                for (size_t x = 0; x < side; ++x)
+                    changed += map.getEntity(x, y) != before.getEntity(x, y);
+            sink = changed;
+        });
+        const double compare = measure([&] { sink = map.diff(before).size(); });
+        row("map diff", side, compareLoop, {compare});
+    }
+}
+
+int main()
+{
+    std::vector<const Arcade::kernels::Table *> tables {&Arcade::kernels::scalar::table};
+#ifdef ARCADE_KERNELS_X86
+    tables.push_back(&Arcade::kernels::sse2::table);
+    if (&Arcade::kernels::select("") == &Arcade::kernels::avx2::table)
+        tables.push_back(&Arcade::kernels::avx2::table);
+#endif
+    std::printf("%-10s %11s %12s", "operation", "board", "loop (us)");
+    for (const auto *table : tables)
+        std::printf(" %12s %8s", table->name, "(us)");
+    std::printf("\n");
+    for (const size_t side : {20, 256, 4096})
+        benchKernels(makeBoard(side), tables);
+    std::printf("\n%-10s %11s %12s %12s\n", "GameMap", "board", "loop (us)", "kernels (us)");
+    for (const size_t side : {20, 256, 4096})
+        benchMap(side);
+    return 0;
+}
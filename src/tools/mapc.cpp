@@ -0,0 +1,47 @@
+/*
+**  _                                              _      ___    ___
+** | |                                            | |    |__ \  / _ \
+** | |_Created _       _ __   _ __    ___    __ _ | |__     ) || (_) |
+** | '_ \ | | | |     | '_ \ | '_ \  / _ \  / _` || '_ \   / /  \__, |
+** | |_) || |_| |     | | | || | | || (_) || (_| || | | | / /_    / /
+** |_.__/  \__, |     |_| |_||_| |_| \___/  \__,_||_| |_||____|  /_/
+**          __/ |     on 18/10/26.
+**         |___/
+*/
+
+#include <fstream>
+#include <iostream>
+
+#include "levelFile.hpp"
+
+// arcade_mapc <carte.map> <niveau.lvl> : compile une carte texte
+int main(int ac, char **av)
+{
+    if (ac != 3) {
+        std::cerr << "Usage: " << av[0] << " <level.map> <level.lvl>" << std::endl;
+        return 84;
+    }
+    try {
+        Arcade::GameMap map(1, 0, 0);
+        map.chargeMap(av[1]);
+        const std::vector<uint8_t> image = Arcade::compileLevel(map);
+
+        std::ofstream file(av[2], std::ios::binary | std::ios::trunc);
+        if (!file.is_open())
+            throw std::runtime_error(std::string("Could not open level file for writing: ") + av[2]);
+        file.write(reinterpret_cast<const char *>(image.data()), static_cast<std::streamsize>(image.size()));
+        if (!file)
+            throw std::runtime_error(std::string("Could not write level file: ") + av[2]);
+
+        // Relecture immédiate : un .lvl invalide ne doit pas arriver jusqu'au jeu
+        file.close();
+        Arcade::GameMap check(1, 0, 0);
+        Arcade::MappedLevel(av[2]).loadInto(check);
+        if (check.getWidth() != map.getWidth() || check.getHeight() != map.getHeight() || !check.diff(map).empty())
+            throw std::runtime_error(std::string("Compiled level does not match its source: ") + av[1]);
+        return 0;
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << std::endl;
+        return 84;
+    }
+}
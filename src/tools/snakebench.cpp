@@ -0,0 +1,137 @@
+/*
+**  _                                              _      ___    ___
+** | |                                            | |    |__ \  / _ \
+** | |_Created _       _ __   _ __    ___    __ _ | |__     ) || (_) |
+** | '_ \ | | | |     | '_ \ | '_ \  / _ \  / _` || '_ \   / /  \__, |
+** | |_) || |_| |     | | | || | | || (_) || (_| || | | | / /_    / /
+** |_.__/  \__, |     |_| |_||_| |_| \___/  \__,_||_| |_||____|  /_/
+**          __/ |     on 18/10/26.
+**         |___/
+*/
+
+#include <chrono>
+#include <cstdio>
+#include <deque>
+#include <functional>
+#include <random>
+#include <vector>
+
+#include "../games/snakeBatch.hpp"
+#include "../games/snakeBody.hpp"
+
+/*
+ * arcade_snakebench : coût d'un pas de Snake (test de collision avec le
+ * corps, nouvelle tête, queue retirée) pour des serpents de 10, 1 000 et
+ * 100 000 cases, avec l'ancienne deque parcourue à chaque pas et avec
+ * SnakeBody. Puis le débit de SnakeBatch (parties de 20x20 menées par
+ * des entrées aléatoires), en pas de partie par seconde sur un cœur.
+ * Construit par `make bench`, en -O2.
+ */
+namespace
+{
+    constexpr size_t SIDE = 1024;
+
+    volatile uint64_t sink;
+
+    // Durée moyenne d'un appel, en répétant jusqu'à ~50 ms
+    double measure(const std::function<void()>& run)
+    {
+        using clock = std::chrono::steady_clock;
+        run();
+        size_t calls = 0;
+        const auto start = clock::now();
+        auto now = start;
+        do {
+            run();
+            calls++;
+            now = clock::now();
+        } while (now - start < std::chrono::milliseconds(50));
+        return std::chrono::duration<double, std::nano>(now - start).count() / static_cast<double>(calls);
+    }
+
+    // Cycle hamiltonien du plateau : le serpent le suit sans jamais se
+    // mordre, le pire cas pour un parcours du corps
+    std::vector<Arcade::SnakePart> cycle()
+    {
+        std::vector<Arcade::SnakePart> path;
+        path.reserve(SIDE * SIDE);
+        for (size_t y = 0; y < SIDE; ++y) {
+            for (size_t i = 1; i < SIDE; ++i)
+                path.push_back({y % 2 == 0 ? i : SIDE - i, y});
+        }
+        for (size_t y = SIDE; y-- > 0;)
+            path.push_back({0, y});
+        return path;
+    }
+
+    void bench(const std::vector<Arcade::SnakePart>& path, size_t length)
+    {
+        std::deque<Arcade::SnakePart> deque;
+        Arcade::SnakeBody body;
+        body.reset(SIDE, SIDE);
+        for (size_t i = length; i-- > 0;) {
+            deque.push_back(path[i]);
+            body.pushTail(path[i]);
+        }
+
+        size_t next = length;
+        const double loop = measure([&] {
+            const Arcade::SnakePart head = path[next++ % path.size()];
+            bool hit = false;
+            for (auto it = std::next(deque.begin()); it != deque.end(); ++it) {
+                if (head.x == it->x && head.y == it->y) {
+                    hit = true;
+                    break;
+                }
+            }
+            sink = hit;
+            deque.push_front(head);
+            deque.pop_back();
+        });
+
+        next = length;
+        const double ring = measure([&] {
+            const Arcade::SnakePart head = path[next++ % path.size()];
+            const Arcade::SnakePart current = body.head();
+            sink = body.occupied(head.x, head.y) && (head.x != current.x || head.y != current.y);
+            body.pushHead(head);
+            body.popTail();
+        });
+        std::printf("%8zu %14.1f %14.1f   x%.1f\n", length, loop, ring, loop / ring);
+    }
+
+    void benchBatch(size_t games)
+    {
+        constexpr size_t ROUNDS = 64;
+        const Arcade::Input choices[] = {
+            Arcade::Input::UP, Arcade::Input::DOWN, Arcade::Input::LEFT, Arcade::Input::RIGHT,
+            Arcade::Input::NONE, Arcade::Input::NONE, Arcade::Input::NONE, Arcade::Input::NONE,
+        };
+        std::mt19937 rng(42);
+        std::vector<Arcade::Input> inputs(ROUNDS * games);
+        for (auto& input : inputs)
+            input = choices[rng() % 8];
+
+        Arcade::SnakeBatch batch(games);
+        std::vector<int32_t> rewards(games);
+        std::vector<uint8_t> done(games);
+        size_t round = 0;
+        const double step = measure([&] {
+            batch.step(inputs.data() + (round++ % ROUNDS) * games, rewards.data(), done.data());
+            sink = done[0];
+        });
+        std::printf("%8zu %14.3f %14.1f\n", games, step / 1000.0, static_cast<double>(games) / step * 1000.0);
+    }
+}
+
+int main()
+{
+    const std::vector<Arcade::SnakePart> path = cycle();
+    std::printf("%8s %14s %14s\n", "length", "deque (ns)", "ring (ns)");
+    for (const size_t length : {10, 1000, 100000})
+        bench(path, length);
+    std::printf("\n%8s %14s %14s\n", "games", "step (us)", "Msteps/s");
+    for (const size_t games : {1, 1024, 65536})
+        benchBatch(games);
+    return 0;
+}